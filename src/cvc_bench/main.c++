@@ -0,0 +1,207 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+// Benchmarks of the building blocks of ilst_cvc and min_cvc:
+//   - micro benchmarks of each vertex ordering, `ilst()`, `cvc_from_ilst()`, `selection_is_cvc()`,
+//     `Cvc_validator::check()` and `load_graph()`, and
+//   - macro benchmarks of the whole approximation (an ordering and both directions) and of both
+//     exact solvers,
+// on the graphs in the `order_*` subdirectories of the given data directories (by default
+// `data/prepared`) and on generated series of random connected graphs of growing order.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "backtracking.h"
+#include "bitmasking.h"
+#include "csr_graph.h"
+#include "cvc.h"
+#include "graph_io.h"
+#include "ilst.h"
+#include "options.h"
+#include "ordering.h"
+#include "run_stats.h"
+#include "simple_graph.h"
+
+/// The largest orders of the graphs given to the exact solvers.
+constexpr int bitmasking_order_limit{20};
+constexpr int backtracking_order_limit{32};
+
+/// A graph to run the benchmarks on.
+struct Bench_graph {
+    std::string name;
+    std::string path; ///< the file the graph was read from; empty if it was generated
+    Csr_graph g;
+};
+
+/// Generates a random connected graph of order `n` and average degree about `degree`: a random
+/// recursive tree plus uniformly random further edges.
+static Csr_graph random_connected_graph(const int n, const int degree, const std::uint32_t seed)
+{
+    std::mt19937 rng{seed};
+    std::vector<std::pair<int, int>> edges;
+    for (int v{1}; v < n; ++v)
+        edges.emplace_back(std::uniform_int_distribution<int>{0, v - 1}(rng), v);
+
+    const auto target_size = static_cast<std::size_t>(n) * static_cast<std::size_t>(degree) / 2;
+    std::uniform_int_distribution<int> vertex{0, n - 1};
+    for (std::size_t attempts{0}; edges.size() < target_size && attempts < 4 * target_size; ++attempts) {
+        const int u{vertex(rng)};
+        const int v{vertex(rng)};
+        if (u != v) edges.emplace_back(std::min(u, v), std::max(u, v));
+        if (edges.size() == target_size) { // drop the parallel edges and top up again
+            std::ranges::sort(edges);
+            edges.erase(std::ranges::unique(edges).begin(), edges.end());
+        }
+    }
+    std::ranges::sort(edges);
+    edges.erase(std::ranges::unique(edges).begin(), edges.end());
+
+    Simple_graph g{n};
+    for (const auto& [u, v] : edges)
+        g.add_edge(u, v);
+    return Csr_graph{g};
+}
+
+/// Loads the graphs in the `order_*` subdirectories of `dir`, preferring the binary version of a
+/// graph stored in both formats.
+static void load_graphs(const std::filesystem::path& dir, std::deque<Bench_graph>& graphs)
+{
+    namespace fs = std::filesystem;
+    if (!fs::is_directory(dir)) {
+        std::cerr << dir.string() << ": not a directory\n";
+        return;
+    }
+
+    std::map<fs::path, fs::path> files; // from the path without the extension
+    for (const auto& order_dir : fs::directory_iterator{dir}) {
+        if (!order_dir.is_directory() || !order_dir.path().filename().string().starts_with("order_"))
+            continue;
+        for (const auto& file : fs::directory_iterator{order_dir.path()}) {
+            const auto ext = file.path().extension();
+            if (!file.is_regular_file() || (ext != ".txt" && ext != ".csr")) continue;
+            auto stem = file.path();
+            stem.replace_extension();
+            if (const auto [itr, inserted] = files.emplace(stem, file.path()); !inserted && ext == ".csr")
+                itr->second = file.path();
+        }
+    }
+
+    for (const auto& [stem, path] : files) {
+        try {
+            Csr_graph g{load_graph(path.string())};
+            if (g.order() <= 1 || !is_connected(g)) continue;
+            graphs.push_back({stem.lexically_relative(dir).generic_string(), path.string(), std::move(g)});
+        }
+        catch (const std::exception& e) {
+            std::cerr << path.string() << ": " << e.what() << '\n';
+        }
+    }
+}
+
+/// Reports the order and size of `g`, the edges processed per second, and the allocations per
+/// iteration since `allocations_before`.
+static void set_counters(benchmark::State& state, const Csr_graph& g, const std::uint64_t allocations_before)
+{
+    state.counters["n"] = g.order();
+    state.counters["m"] = static_cast<double>(g.size());
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocation_count() - allocations_before),
+                                                  benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * g.size());
+}
+
+/// Registers a benchmark called `<kind>/<graph name>` that times `f()` on every iteration.
+template<typename F>
+static benchmark::internal::Benchmark* add(const std::string& kind, const Bench_graph& bg, F f)
+{
+    const std::string name{kind + '/' + bg.name};
+    return benchmark::RegisterBenchmark(name.c_str(), [&bg, f](benchmark::State& state) mutable {
+        const std::uint64_t allocations_before{allocation_count()};
+        for (auto _ : state)
+            f();
+        set_counters(state, bg.g, allocations_before);
+    });
+}
+
+static void register_benchmarks(const Bench_graph& bg)
+{
+    const Csr_graph& g{bg.g};
+    const std::vector<Strategy_spec> specs{{Ordering_strategy::dd, 1},
+                                           {Ordering_strategy::sl, 1},
+                                           {Ordering_strategy::sll, 1},
+                                           {Ordering_strategy::sd, 1}};
+
+    // micro benchmarks
+    if (!bg.path.empty()) add("load_graph", bg, [&bg]() { benchmark::DoNotOptimize(load_graph(bg.path)); });
+    for (const auto& [strategy, r] : specs)
+        add("ordering/" + std::string{strategy_name(strategy)}, bg, [&g, strategy, r]() {
+            benchmark::DoNotOptimize(vertex_ordering(g, strategy, r));
+        });
+
+    const auto priority = ordering_to_priorities(vertex_ordering(g, Ordering_strategy::sll, 1));
+    add("ilst", bg, [&g, priority]() { benchmark::DoNotOptimize(ilst(g, priority)); });
+
+    const Simple_graph tree{ilst(g, priority)};
+    add("cvc_from_ilst", bg, [&g, tree]() { benchmark::DoNotOptimize(cvc_from_ilst(g, tree)); });
+
+    const auto cvc = cvc_from_ilst(g, tree);
+    add("selection_is_cvc", bg, [&g, cvc]() { benchmark::DoNotOptimize(selection_is_cvc(g, cvc)); });
+    add("validator", bg, [&g, cvc, validator = Cvc_validator{g}]() mutable {
+        benchmark::DoNotOptimize(validator.check(cvc));
+    });
+
+    // macro benchmarks
+    for (const auto& [strategy, r] : specs)
+        add("approximate/" + std::string{strategy_name(strategy)}, bg, [&g, strategy, r]() {
+            Cvc_validator validator{g};
+            auto ordering = vertex_ordering(g, strategy, r);
+            benchmark::DoNotOptimize(cvc_for_ordering(validator, ordering));
+            std::ranges::reverse(ordering);
+            benchmark::DoNotOptimize(cvc_for_ordering(validator, ordering));
+        })->Unit(benchmark::kMicrosecond);
+
+    if (g.order() <= backtracking_order_limit)
+        add("exact/backtracking", bg, [&g]() { benchmark::DoNotOptimize(find_cvc_by_backtracking(g, 1)); })
+            ->Unit(benchmark::kMillisecond);
+    if (g.order() <= bitmasking_order_limit)
+        add("exact/bitmasking", bg, [&g]() { benchmark::DoNotOptimize(find_cvc_by_bitmasking(g, 1)); })
+            ->Unit(benchmark::kMillisecond);
+}
+
+int main(int argc, char* argv[])
+{
+    benchmark::Initialize(&argc, argv);
+    enable_allocation_counting();
+
+    std::vector<std::filesystem::path> dirs(argv + 1, argv + argc);
+    if (dirs.empty()) dirs.emplace_back("data/prepared");
+
+    std::deque<Bench_graph> graphs; // keeps the graphs in place for the registered benchmarks
+    for (const auto& dir : dirs)
+        load_graphs(dir, graphs);
+
+    // scaling series: sparse graphs of doubling order for the heuristics, and small ones of growing
+    // order for the exact solvers
+    for (int n{256}; n <= 65536; n *= 2)
+        graphs.push_back({"generated/deg8_n" + std::to_string(n), "", random_connected_graph(n, 8, 1)});
+    for (int n{8}; n <= backtracking_order_limit; n += 4)
+        graphs.push_back({"generated/deg3_n" + std::to_string(n), "", random_connected_graph(n, 3, 1)});
+
+    for (const auto& bg : graphs)
+        register_benchmarks(bg);
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return EXIT_SUCCESS;
+}
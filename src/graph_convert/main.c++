@@ -0,0 +1,63 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#include "csr_graph.h"
+#include "graph_io.h"
+
+/// Prints a help message showing the syntax of the command line.
+void show_usage(const char* const cmd_name)
+{
+    std::cerr << "usage: " << cmd_name << " <graph file>...\n"
+              << "Writes every graph file `<name>.txt` in the binary format to `<name>.csr`.\n";
+}
+
+int main(const int argc, const char* const argv[])
+{
+    const auto args = std::span(argv, static_cast<std::size_t>(argc));
+    if (args.size() < 2) {
+        show_usage(args[0]);
+        return EXIT_FAILURE;
+    }
+
+    bool all_converted{true};
+    for (const auto* const arg : args.subspan(1)) {
+        const std::filesystem::path input{arg};
+        auto output = input;
+        output.replace_extension(".csr");
+        if (output == input) {
+            std::cerr << input.string() << ": already has the .csr extension\n";
+            all_converted = false;
+            continue;
+        }
+
+        try {
+            const Csr_graph g{load_graph(input.string())};
+            std::ofstream os{output, std::ios_base::binary};
+            write_binary_graph(g, os);
+            if (!os.flush()) {
+                std::cerr << output.string() << ": cannot write file\n";
+                all_converted = false;
+            }
+        }
+        catch (const std::runtime_error& e) { // already names the file
+            std::cerr << e.what() << '\n';
+            all_converted = false;
+        }
+        catch (const std::exception& e) {
+            std::cerr << input.string() << ": " << e.what() << '\n';
+            all_converted = false;
+        }
+    }
+
+    return all_converted ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,67 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#include "batch.h"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <iostream>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "csr_graph.h"
+#include "cvc.h"
+#include "graph_io.h"
+#include "options.h"
+#include "ordering.h"
+
+/// Returns the cardinality of `cvc`, or -1 if it is empty (i.e. failed validation).
+static int cardinality(const std::vector<int>& cvc)
+{
+    return cvc.empty() ? -1 : static_cast<int>(cvc.size());
+}
+
+bool run_batch(std::istream& manifest, const std::vector<Strategy_spec>& specs, std::ostream& out)
+{
+    bool all_solved{true};
+    out << "graph\theuristic\tr\tfwd\trev\n";
+
+    for (std::string path; std::getline(manifest, path);) {
+        if (path.empty() || path.front() == '#') continue;
+
+        try {
+            const Csr_graph g{load_graph(path)};
+            if (g.order() <= 1 || !is_connected(g)) {
+                std::cerr << path << ": graph must be connected and have at least 2 vertices\n";
+                all_solved = false;
+                continue;
+            }
+
+            Cvc_validator validator{g};
+            for (const auto& [strategy, r] : specs) {
+                auto ordering = vertex_ordering(g, strategy, r);
+                const int fwd{cardinality(cvc_for_ordering(validator, ordering))};
+                std::ranges::reverse(ordering);
+                const int rev{cardinality(cvc_for_ordering(validator, ordering))};
+
+                out << path << '\t' << strategy_name(strategy) << '\t';
+                if (strategy == Ordering_strategy::sll) out << r;
+                out << '\t' << fwd << '\t' << rev << '\n';
+            }
+            out.flush();
+        }
+        catch (const std::runtime_error& e) { // already names the file
+            std::cerr << e.what() << '\n';
+            all_solved = false;
+        }
+        catch (const std::exception& e) {
+            std::cerr << path << ": " << e.what() << '\n';
+            all_solved = false;
+        }
+    }
+
+    return all_solved;
+}
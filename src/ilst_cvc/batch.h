@@ -0,0 +1,26 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef BATCH_H_INCLUDED
+#define BATCH_H_INCLUDED
+
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "options.h"
+
+/// Solves every graph listed in `manifest` (one file path per line; blank lines and lines starting
+/// with `#` are skipped) with every heuristic in `specs`, in both directions.  Each graph is read
+/// and checked for connectivity once.  Writes a header and then one tab-separated row per graph
+/// and heuristic to `out`:
+///
+///     graph  heuristic  r  fwd  rev
+///
+/// where `r` is empty for heuristics other than sll and `fwd` and `rev` are the cardinalities of
+/// the covers found in the forward and reverse direction (-1 if a cover fails validation).
+/// Graphs that cannot be read or are not connected are reported on `std::cerr` and skipped.
+/// Returns true iff every graph was solved.
+bool run_batch(std::istream& manifest, const std::vector<Strategy_spec>& specs, std::ostream& out);
+
+#endif // BATCH_H_INCLUDED
@@ -0,0 +1,147 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#include "cvc.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.h"
+#include "ilst.h"
+#include "simple_graph.h"
+
+bool is_connected(const Csr_graph& g)
+{
+    std::vector<bool> is_visited(g.order(), false);
+    // const std::function<void(const int)> dfs = [&](const int v) {
+    //     is_visited[v] = true;
+    //     for (const auto u : g.neighbors(v))
+    //         if (!is_visited[u]) dfs(u);
+    // };
+    // dfs(0);
+
+    std::vector<int> stack{0};
+    stack.reserve(g.order());
+    is_visited[0] = true;
+    while (!stack.empty()) {
+        const int v{stack.back()};
+        stack.pop_back();
+        for (const auto u : g.neighbors(v))
+            if (!is_visited[u]) {
+                is_visited[u] = true;
+                stack.push_back(u);
+            }
+    }
+
+    // NOLINTNEXTLINE(*-simplify-boolean-expr)
+    return std::ranges::all_of(is_visited, [](const bool status) { return status == true; });
+}
+
+std::vector<int> ordering_to_priorities(const std::vector<int>& ordering)
+{
+    std::vector<int> priority(ordering.size());
+    const auto n = static_cast<int>(ordering.size());
+    for (int i{0}; i < n; ++i)
+        priority[ordering[i]] = n - i - 1;
+    return priority;
+}
+
+std::vector<int> cvc_from_ilst(const Csr_graph& g, const Simple_graph& ilst_tree)
+{
+    std::vector<int> res;
+    for (int v{0}; v < ilst_tree.order(); ++v)
+        if (ilst_tree.degree(v) > 1) res.push_back(v);
+
+    // One of the leaves should be included iff g is a ring.
+    // And if g is a ring, ilst_tree has two leaves and they are not g-independent.
+    if (const int nleaves{g.order() - static_cast<int>(res.size())}; nleaves == 2) {
+        int l1{0};
+        for (; l1 < ilst_tree.order(); ++l1)
+            if (ilst_tree.degree(l1) == 1) break;
+
+        int l2{l1 + 1};
+        for (; l2 < ilst_tree.order(); ++l2)
+            if (ilst_tree.degree(l2) == 1) break;
+
+        // if l1 and l2 are not g-independent, add l1 to the result
+        if (const auto nn = g.neighbors(l1); std::ranges::find(nn, l2) != nn.end())
+            res.push_back(l1);
+    }
+
+    return res;
+}
+
+Cvc_validator::Cvc_validator(const Csr_graph& g) : _g{g}, _mark(static_cast<std::size_t>(g.order()), 0)
+{
+    _stack.reserve(static_cast<std::size_t>(g.order()));
+}
+
+Cvc_validator::Result Cvc_validator::check(const std::span<const int> selection)
+{
+    if (_stamp > std::numeric_limits<int>::max() - 2) {
+        std::ranges::fill(_mark, 0);
+        _stamp = 0;
+    }
+    _stamp += 2;
+    const int selected{_stamp};
+    const int visited{_stamp + 1};
+
+    int root{_g.order()};
+    for (const auto v : selection) {
+        mark(v) = selected;
+        root = std::min(root, v);
+    }
+
+    // an edge is uncovered iff both its ends are unselected
+    Result res;
+    for (int v{0}; v < _g.order(); ++v) {
+        if (mark(v) == selected) continue;
+        for (const auto u : _g.neighbors(v))
+            if (mark(u) != selected) {
+                res.is_cvc = false;
+                res.uncovered_edge = {std::min(u, v), std::max(u, v)};
+                return res;
+            }
+    }
+    if (selection.empty()) return res;
+
+    _stack.clear();
+    _stack.push_back(root);
+    mark(root) = visited;
+    while (!_stack.empty()) {
+        const int v{_stack.back()};
+        _stack.pop_back();
+        for (const auto u : _g.neighbors(v))
+            if (mark(u) == selected) {
+                mark(u) = visited;
+                _stack.push_back(u);
+            }
+    }
+
+    // any selected vertex left unvisited is not connected to root
+    for (const auto v : selection)
+        if (mark(v) != visited) {
+            res.is_cvc = false;
+            res.disconnected_vertex = v;
+            return res;
+        }
+    return res;
+}
+
+bool selection_is_cvc(const Csr_graph& g, const std::vector<int>& selection)
+{
+    Cvc_validator validator{g};
+    return static_cast<bool>(validator.check(selection));
+}
+
+std::vector<int> cvc_for_ordering(Cvc_validator& validator, const std::vector<int>& ordering)
+{
+    const Csr_graph& g{validator.graph()};
+    std::vector<int> cvc{cvc_from_ilst(g, ilst(g, ordering_to_priorities(ordering)))};
+    if (!validator.check(cvc)) cvc.clear();
+    return cvc;
+}
@@ -0,0 +1,63 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef CVC_H_INCLUDED
+#define CVC_H_INCLUDED
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.h"
+#include "simple_graph.h"
+
+/// Checks if `g` is connected.
+bool is_connected(const Csr_graph& g);
+
+/// Converts a vertex ordering into priorities: the first vertex gets the highest priority.
+std::vector<int> ordering_to_priorities(const std::vector<int>& ordering);
+
+/// Returns the connected vertex cover of `g` formed by the inner vertices of `ilst_tree`, an
+/// ILST of `g` (plus one of the leaves if `g` is a ring).
+std::vector<int> cvc_from_ilst(const Csr_graph& g, const Simple_graph& ilst_tree);
+
+/// Checks selections of the vertices of a graph for being connected vertex covers in O(n + m) time,
+/// reusing its scratch buffers across checks instead of allocating.
+class Cvc_validator {
+public:
+    /// The outcome of a check, with a witness of the failure if the selection is not a cover.
+    struct Result {
+        bool is_cvc{true};
+        std::pair<int, int> uncovered_edge{-1, -1}; ///< an edge with no selected end
+        int disconnected_vertex{-1}; ///< a selected vertex not connected to the lowest selected one
+
+        explicit operator bool() const { return is_cvc; }
+    };
+
+    explicit Cvc_validator(const Csr_graph& g);
+
+    /// Checks if the `selection` of vertices (in any order, possibly repeated) forms a connected
+    /// vertex cover of the graph: every edge must have a selected end, and a traversal of the
+    /// selected vertices from the lowest one must reach all of them.
+    Result check(std::span<const int> selection);
+
+    [[nodiscard]] const Csr_graph& graph() const { return _g; }
+
+private:
+    const Csr_graph& _g;
+    std::vector<int> _mark;  ///< `_stamp` for selected vertices, `_stamp + 1` for visited ones
+    std::vector<int> _stack; ///< the traversal stack
+    int _stamp{0};
+
+    int& mark(const int v) { return _mark[static_cast<std::size_t>(v)]; }
+};
+
+/// Checks if the `selection` of vertices forms a connected vertex cover of `g`.
+bool selection_is_cvc(const Csr_graph& g, const std::vector<int>& selection);
+
+/// Builds an ILST of the graph of `validator` guided by `ordering` and returns the connected vertex
+/// cover derived from it, or an empty vector if that fails validation.
+std::vector<int> cvc_for_ordering(Cvc_validator& validator, const std::vector<int>& ordering);
+
+#endif // CVC_H_INCLUDED
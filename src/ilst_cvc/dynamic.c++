@@ -0,0 +1,262 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#include "dynamic.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.h"
+#include "cvc.h"
+#include "ilst.h"
+#include "options.h"
+#include "ordering.h"
+#include "simple_graph.h"
+
+/// Returns true iff `u` and `v` are neighbors in `g`.
+static bool adjacent(const Simple_graph& g, const int u, const int v)
+{
+    // search the shorter neighbor list
+    const auto [x, y] = g.degree(u) <= g.degree(v) ? std::pair{u, v} : std::pair{v, u};
+    const auto neighs = g.neighbors(x);
+    return std::ranges::find(neighs, y) != neighs.end();
+}
+
+Dynamic_cvc::Dynamic_cvc(const Csr_graph& g, const Strategy_spec& spec) :
+    _g{g.order()}, _spec{spec}, _tree{g.order()}, _mark(static_cast<std::size_t>(g.order()), 0)
+{
+    for (int v{0}; v < g.order(); ++v)
+        for (const auto u : g.neighbors(v))
+            if (v < u) _g.add_edge(v, u);
+    rebuild();
+}
+
+bool Dynamic_cvc::insert_edge(const int u, const int v)
+{
+    if (u == v || u < 0 || v < 0 || u >= _g.order() || v >= _g.order() || adjacent(_g, u, v))
+        return false;
+
+    _g.add_edge(u, v);
+    ++_nupdates;
+    if (_needs_rebuild) return true;
+
+    if (is_leaf(u) && is_leaf(v)) {
+        ++_nuncovered;
+        _dirty.push_back(u);
+    }
+    return true;
+}
+
+bool Dynamic_cvc::erase_edge(const int u, const int v)
+{
+    if (u == v || u < 0 || v < 0 || u >= _g.order() || v >= _g.order() || !_g.remove_edge(u, v))
+        return false;
+
+    ++_nupdates;
+    if (_needs_rebuild) return true;
+
+    if (is_leaf(u) && is_leaf(v)) --_nuncovered;
+    if (adjacent(_tree, u, v)) {
+        remove_tree_edge(u, v);
+        if (!reconnect(u, v)) _needs_rebuild = true;
+    }
+    return true;
+}
+
+std::vector<int> Dynamic_cvc::cover()
+{
+    if (!_needs_rebuild) {
+        for (int budget{4 * _nupdates + 16}; !is_valid(); --budget) {
+            if (budget == 0 || !repair_one()) {
+                _needs_rebuild = true;
+                break;
+            }
+        }
+    }
+    _nupdates = 0;
+    _dirty.clear();
+    if (_needs_rebuild) rebuild();
+    if (_needs_rebuild) return {};
+
+    std::vector<int> res;
+    for (int v{0}; v < _tree.order(); ++v)
+        if (!is_leaf(v)) res.push_back(v);
+    if (_nuncovered == 0) return res;
+
+    // Cover each remaining edge between two leaves with its smaller end, as `cvc_from_ilst()` does
+    // for the leaves of a Hamiltonian path; a leaf hangs from an inner vertex (or is one of the two
+    // vertices of the graph), so the cover stays connected.
+    std::vector<int> leaves;
+    for (int v{0}; v < _tree.order(); ++v) {
+        if (!is_leaf(v)) continue;
+        const auto neighs = _g.neighbors(v);
+        if (std::ranges::any_of(neighs, [&](const int u) {
+                return is_leaf(u) && (u > v || !std::ranges::binary_search(leaves, u));
+            }))
+            leaves.push_back(v);
+    }
+    std::vector<int> merged;
+    std::ranges::merge(res, leaves, std::back_inserter(merged));
+    return merged;
+}
+
+int Dynamic_cvc::uncovered_around(const int u, const int v) const
+{
+    const auto uncovered_at = [this](const int x) -> int {
+        if (!is_leaf(x)) return 0;
+        return static_cast<int>(
+            std::ranges::count_if(_g.neighbors(x), [this](const int y) { return is_leaf(y); }));
+    };
+
+    int res{uncovered_at(u) + uncovered_at(v)};
+    if (is_leaf(u) && is_leaf(v) && adjacent(_g, u, v)) --res;
+    return res;
+}
+
+void Dynamic_cvc::add_tree_edge(const int u, const int v)
+{
+    const bool u_was_leaf{is_leaf(u)};
+    const bool v_was_leaf{is_leaf(v)};
+    _nuncovered -= uncovered_around(u, v);
+    _tree.add_edge(u, v);
+    _nuncovered += uncovered_around(u, v);
+    _nleaves += (is_leaf(u) ? 1 : 0) - (u_was_leaf ? 1 : 0) + (is_leaf(v) ? 1 : 0) - (v_was_leaf ? 1 : 0);
+    if (is_leaf(u) && !u_was_leaf) _dirty.push_back(u);
+    if (is_leaf(v) && !v_was_leaf) _dirty.push_back(v);
+}
+
+void Dynamic_cvc::remove_tree_edge(const int u, const int v)
+{
+    const bool u_was_leaf{is_leaf(u)};
+    const bool v_was_leaf{is_leaf(v)};
+    _nuncovered -= uncovered_around(u, v);
+    _tree.remove_edge(u, v);
+    _nuncovered += uncovered_around(u, v);
+    _nleaves += (is_leaf(u) ? 1 : 0) - (u_was_leaf ? 1 : 0) + (is_leaf(v) ? 1 : 0) - (v_was_leaf ? 1 : 0);
+    if (is_leaf(u) && !u_was_leaf) _dirty.push_back(u);
+    if (is_leaf(v) && !v_was_leaf) _dirty.push_back(v);
+}
+
+bool Dynamic_cvc::reconnect(const int u, const int v)
+{
+    // Search the halves containing u and v in lockstep, so that the search stops after visiting
+    // twice the smaller half.
+    const int u_stamp{++_stamp};
+    const int v_stamp{++_stamp};
+    std::vector<int> u_half{u};
+    std::vector<int> v_half{v};
+    mark(u) = u_stamp;
+    mark(v) = v_stamp;
+
+    const auto grow = [this](std::vector<int>& half, std::size_t& next, const int stamp) -> bool {
+        if (next == half.size()) return false;
+        for (const auto y : _tree.neighbors(half[next++]))
+            if (mark(y) != stamp) {
+                mark(y) = stamp;
+                half.push_back(y);
+            }
+        return true;
+    };
+    std::size_t u_next{0};
+    std::size_t v_next{0};
+    for (;;) {
+        if (!grow(u_half, u_next, u_stamp)) break;
+        if (!grow(v_half, v_next, v_stamp)) {
+            std::swap(u_half, v_half);
+            break;
+        }
+    }
+    // `u_half` is now complete and at most as large as the other half
+    const int stamp{mark(u_half.front())};
+
+    for (const auto x : u_half)
+        for (const auto y : _g.neighbors(x))
+            if (mark(y) != stamp) {
+                add_tree_edge(x, y);
+                return true;
+            }
+    return false;
+}
+
+bool Dynamic_cvc::repair_one()
+{
+    while (!_dirty.empty()) {
+        int a{_dirty.back()};
+        if (!is_leaf(a)) {
+            _dirty.pop_back();
+            continue;
+        }
+        const auto neighs = _g.neighbors(a);
+        const auto itr = std::ranges::find_if(neighs, [this](const int y) { return is_leaf(y); });
+        if (itr == neighs.end()) {
+            _dirty.pop_back();
+            continue;
+        }
+
+        // Hang b from a, making a an inner vertex, unless b's tree neighbor would turn into a leaf
+        // and a's would not.
+        int b{*itr};
+        int pb{_tree.neighbors(b).front()};
+        if (pb == a) return false; // the tree is the single edge (a, b)
+        if (const int pa{_tree.neighbors(a).front()}; _tree.degree(pb) < 3 && _tree.degree(pa) >= 3) {
+            std::swap(a, b);
+            pb = pa;
+        }
+        remove_tree_edge(b, pb);
+        add_tree_edge(a, b);
+        return true;
+    }
+    return false;
+}
+
+/// Returns the representative of the set of `v` in the disjoint-set forest `parent`.
+static int find_set(std::vector<int>& parent, int v)
+{
+    const auto at = [&parent](const int x) -> int& { return parent[static_cast<std::size_t>(x)]; };
+    while (at(v) != v)
+        v = at(v) = at(at(v));
+    return v;
+}
+
+void Dynamic_cvc::rebuild()
+{
+    _needs_rebuild = true;
+    const Csr_graph g{_g};
+    if (!is_connected(g)) return;
+
+    // `ilst()` can return a subgraph that is not a spanning tree (when the leaf-to-root walk of its
+    // last step passes the root), for which `cvc_for_ordering()` rejects the cover.  Keep the edges
+    // of the ILST that form no cycle and complete them to a spanning tree with edges of the graph.
+    const Simple_graph ilst_tree{ilst(g, ordering_to_priorities(vertex_ordering(g, _spec.strategy, _spec.r)))};
+    _tree = Simple_graph{g.order()};
+    std::vector<int> parent(static_cast<std::size_t>(g.order()));
+    std::iota(parent.begin(), parent.end(), 0);
+    const auto join = [&](const Simple_graph& h) {
+        for (int v{0}; v < h.order(); ++v)
+            for (const auto u : h.neighbors(v)) {
+                if (v > u) continue;
+                const int rv{find_set(parent, v)};
+                const int ru{find_set(parent, u)};
+                if (rv == ru) continue;
+                parent[static_cast<std::size_t>(rv)] = ru;
+                _tree.add_edge(v, u);
+            }
+    };
+    join(ilst_tree);
+    join(_g);
+
+    _nleaves = 0;
+    _nuncovered = 0;
+    for (int v{0}; v < _g.order(); ++v) {
+        if (!is_leaf(v)) continue;
+        ++_nleaves;
+        for (const auto u : _g.neighbors(v))
+            if (v < u && is_leaf(u)) ++_nuncovered;
+    }
+    _needs_rebuild = false;
+    ++_rebuilds;
+}
@@ -0,0 +1,84 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef DYNAMIC_H_INCLUDED
+#define DYNAMIC_H_INCLUDED
+
+#include <cstddef>
+#include <vector>
+
+#include "csr_graph.h"
+#include "options.h"
+#include "simple_graph.h"
+
+/// Maintains an ILST-based connected vertex cover of a graph under edge insertions and deletions.
+///
+/// The inner vertices of a spanning tree of the graph form a connected vertex cover iff no edge of
+/// the graph joins two leaves of the tree (save for the one between the two leaves of a Hamiltonian
+/// path, which `cvc_from_ilst()` covers with one of them).  So the tree is kept spanning and the
+/// number of such uncovered edges is counted as the tree and the graph change:
+///   - a deleted tree edge is replaced by a graph edge reconnecting the two halves of the tree,
+///     found by searching the smaller half;
+///   - an uncovered edge between the leaves `a` and `b` is covered by moving `b` from its tree
+///     neighbor to `a`, which makes `a` an inner vertex.
+/// Only if these local repairs fail to cover every edge within a budget proportional to the number
+/// of updates is the ILST rebuilt from scratch with the ordering heuristic; edges the rebuilt tree
+/// leaves uncovered are covered with one of their ends.
+class Dynamic_cvc {
+public:
+    /// Builds the ILST of `g` with the ordering heuristic `spec`.
+    Dynamic_cvc(const Csr_graph& g, const Strategy_spec& spec);
+
+    /// Adds the edge between `u` and `v`.  Returns false, changing nothing, if it is a self-loop,
+    /// already exists or has an endpoint out of range.
+    bool insert_edge(const int u, const int v);
+
+    /// Removes the edge between `u` and `v`.  Returns false, changing nothing, if it does not exist.
+    bool erase_edge(const int u, const int v);
+
+    /// Repairs the tree after a batch of updates and returns the connected vertex cover in
+    /// increasing order, or an empty vector if the graph is currently disconnected.
+    std::vector<int> cover();
+
+    /// Returns the number of times the ILST has been rebuilt from scratch since construction.
+    [[nodiscard]] int rebuilds() const { return _rebuilds; }
+
+private:
+    Simple_graph _g;
+    Strategy_spec _spec;
+    Simple_graph _tree;
+    bool _needs_rebuild{true}; ///< whether `_tree` is not a spanning tree of `_g`
+    int _rebuilds{-1};
+
+    int _nleaves{0};    ///< number of leaves of `_tree`
+    int _nuncovered{0}; ///< number of edges of `_g` between two leaves of `_tree`
+    int _nupdates{0};   ///< number of updates since the last call of `cover()`
+    std::vector<int> _dirty; ///< vertices that may have become endpoints of uncovered edges
+
+    std::vector<int> _mark; ///< scratch marks for the searches in `reconnect()`
+    int _stamp{0};          ///< the current value of a set mark in `_mark`
+
+    int& mark(const int v) { return _mark[static_cast<std::size_t>(v)]; }
+    [[nodiscard]] bool is_leaf(const int v) const { return _tree.degree(v) == 1; }
+    [[nodiscard]] bool is_valid() const
+    {
+        return _nuncovered == 0 || (_nuncovered == 1 && _nleaves == 2);
+    }
+
+    /// Returns the number of uncovered edges incident to `u` or `v`.
+    [[nodiscard]] int uncovered_around(const int u, const int v) const;
+
+    void add_tree_edge(const int u, const int v);
+    void remove_tree_edge(const int u, const int v);
+
+    /// Finds an edge of `_g` joining the halves of `_tree` containing `u` and `v` and adds it to
+    /// `_tree`.  Returns false if there is none.
+    bool reconnect(const int u, const int v);
+
+    /// Finds an uncovered edge at a dirty vertex and covers it.  Returns false if there is none.
+    bool repair_one();
+
+    void rebuild();
+};
+
+#endif // DYNAMIC_H_INCLUDED
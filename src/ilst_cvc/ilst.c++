@@ -2,21 +2,28 @@
 // PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
 
 #include <algorithm>
+#include <span>
 #include <utility>
 #include <vector>
 
+#include "csr_graph.h"
 #include "simple_graph.h"
 
 // ReSharper disable CppTemplateArgumentsCanBeDeduced
 
-std::pair<Simple_graph, int> dfs_traversal(const Simple_graph& g, const int root, const std::vector<int>& priority)
+std::pair<Simple_graph, int> dfs_traversal(const Csr_graph& g, const int root, const std::vector<int>& priority)
 {
-    auto adj = g.adj_data();
+    // a single flat copy of the neighbor lists, each row sorted by decreasing priority
+    const auto offsets = g.offsets();
+    std::vector<int> adj(g.targets().begin(), g.targets().end());
     const auto cmp = [&priority](const int u, const int v) {
         return priority[u] > priority[v];
     };
-    for (auto& neighbors : adj)
-        std::ranges::sort(neighbors, cmp);
+    const auto row = [&](const int v) {
+        return std::span<int>{adj}.subspan(offsets[v], offsets[v + 1] - offsets[v]);
+    };
+    for (int v{0}; v < g.order(); ++v)
+        std::ranges::sort(row(v), cmp);
 
     Simple_graph dfs_tree{g.order()};
     std::vector<bool> is_visited(g.order(), false);
@@ -26,15 +33,15 @@ std::pair<Simple_graph, int> dfs_traversal(const Simple_graph& g, const int root
 
     while (!sources_stack.empty()) {
         auto& [source, neigh_offset] = sources_stack.back();
-        const auto& neighbors = adj[source];
+        const auto neighbors = row(source);
 
         const auto dest_itr =
-            std::find_if_not(neighbors.cbegin() + neigh_offset,
-                             neighbors.cend(),
+            std::find_if_not(neighbors.begin() + neigh_offset,
+                             neighbors.end(),
                              [&is_visited](const int u) { return is_visited[u]; });
-        if (dest_itr == neighbors.cend()) {
+        if (dest_itr == neighbors.end()) {
             if (leaf_adj_to_root == -1 && dfs_tree.degree(source) == 1 &&
-                std::ranges::find(neighbors, root) != neighbors.cend()) {
+                std::ranges::find(neighbors, root) != neighbors.end()) {
                 leaf_adj_to_root = source;
             }
             sources_stack.pop_back();
@@ -44,7 +51,7 @@ std::pair<Simple_graph, int> dfs_traversal(const Simple_graph& g, const int root
 
         dfs_tree.add_edge(source, dest);
         is_visited[dest] = true;
-        neigh_offset = static_cast<int>(dest_itr - neighbors.cbegin()) + 1;
+        neigh_offset = static_cast<int>(dest_itr - neighbors.begin()) + 1;
         sources_stack.emplace_back(dest, 0);
     }
 
@@ -56,10 +63,10 @@ std::pair<int, int> closest_branch(const Simple_graph& tree, const int leaf)
     std::pair<int, int> child_parent{-1, leaf};
     const auto move_up = [&]() -> bool {
         const auto& [c, p] = child_parent;
-        const auto& neighs = tree.neighbors(p);
+        const auto neighs = tree.neighbors(p);
         const auto itr = std::ranges::find_if(neighs, [&c](const int u) -> bool { return u != c; });
 
-        if (itr == neighs.cend()) {
+        if (itr == neighs.end()) {
             child_parent = {p, -1};
             return false;
         }
@@ -73,7 +80,7 @@ std::pair<int, int> closest_branch(const Simple_graph& tree, const int leaf)
     return child_parent;
 }
 
-Simple_graph ilst(const Simple_graph& g, const std::vector<int>& priority)
+Simple_graph ilst(const Csr_graph& g, const std::vector<int>& priority)
 {
     const auto root = static_cast<int>(std::ranges::max_element(priority) - priority.cbegin());
 
@@ -6,8 +6,9 @@
 
 #include <vector>
 
+#include "csr_graph.h"
 #include "simple_graph.h"
 
-Simple_graph ilst(const Simple_graph& g, const std::vector<int>& priority);
+Simple_graph ilst(const Csr_graph& g, const std::vector<int>& priority);
 
 #endif // ILST_H_INCLUDED
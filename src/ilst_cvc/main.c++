@@ -2,176 +2,211 @@
 // PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
 
 #include <algorithm>
-#include <cstdint>
 #include <cstdlib>
 #include <cstring>
-#include <functional>
-#include <ios>
+#include <exception>
+#include <fstream>
 #include <iostream>
-#include <iterator>
-#include <set>
+#include <optional>
+#include <span>
 #include <stdexcept>
 #include <string>
-#include <utility>
+#include <thread>
 #include <vector>
 
+#include "batch.h"
+#include "csr_graph.h"
+#include "cvc.h"
+#include "dynamic.h"
+#include "graph_io.h"
 #include "ilst.h"
+#include "options.h"
 #include "ordering.h"
+#include "portfolio.h"
+#include "run_stats.h"
 #include "simple_graph.h"
 
 // ReSharper disable CppTemplateArgumentsCanBeDeduced
 
-constexpr int r_limit{32};
-enum class Ordering_strategy : std::uint8_t { dd, sl, sll, sd };
-
-template<typename T> constexpr T scan(std::istream& is = std::cin)
-{
-    T buf;
-    is >> buf;
-    return buf;
-}
-
 void show_usage(const char* const cmd_name)
 {
     std::cerr << "Usage: " << cmd_name
-              << " <ordering heuristic: (dd|sl|sll|sd)> [<the r parameter if heuristic is sll>]:\n"
+              << " [--stats] <ordering heuristic: (dd|sl|sll|sd)> [<the r parameter if heuristic is sll>]:\n"
               << '\t' << cmd_name << " dd\n"
               << '\t' << cmd_name << " sl\n"
               << '\t' << cmd_name << " sll <r>\n"
-              << '\t' << cmd_name << " sd\n";
+              << '\t' << cmd_name << " sd\n"
+              << "   or: " << cmd_name << " --batch <manifest file or -> <heuristic> [<r>...]...\n"
+              << "   or: " << cmd_name
+              << " --portfolio [-j <threads>] [-n <perturbations>] [-t <seconds>] [-s <seed>]"
+                 " [<heuristic> [<r>...]...]\n"
+              << "   or: " << cmd_name << " --dynamic <graph file> <heuristic> [<r>]\n";
 }
 
-bool is_connected(const Simple_graph& g)
+void print_integers(const std::vector<int>& ints)
 {
-    std::vector<bool> is_visited(g.order(), false);
-    // const std::function<void(const int)> dfs = [&](const int v) {
-    //     is_visited[v] = true;
-    //     for (const auto u : g.neighbors(v))
-    //         if (!is_visited[u]) dfs(u);
-    // };
-    // dfs(0);
-
-    std::vector<int> stack{0};
-    stack.reserve(g.order());
-    is_visited[0] = true;
-    while (!stack.empty()) {
-        const int v{stack.back()};
-        stack.pop_back();
-        for (const auto u : g.neighbors(v))
-            if (!is_visited[u]) {
-                is_visited[u] = true;
-                stack.push_back(u);
-            }
+    for (unsigned i{0}; i < ints.size(); ++i) {
+        if (i != 0) std::cout << ' ';
+        std::cout << ints[i];
     }
-
-    // NOLINTNEXTLINE(*-simplify-boolean-expr)
-    return std::ranges::all_of(is_visited, [](const bool status) { return status == true; });
 }
 
-std::vector<int> ordering_to_priorities(const std::vector<int>& ordering)
+/// Runs the batch mode on the command-line arguments following `--batch`.
+int batch_main(const std::span<const char* const> args, const char* const cmd_name)
 {
-    std::vector<int> priority(ordering.size());
-    const auto n = static_cast<int>(ordering.size());
-    for (int i{0}; i < n; ++i)
-        priority[ordering[i]] = n - i - 1;
-    return priority;
-}
-
-std::vector<int> cvc_from_ilst(const Simple_graph& g, const Simple_graph& ilst_tree)
-{
-    std::vector<int> res;
-    for (int v{0}; v < ilst_tree.order(); ++v)
-        if (ilst_tree.degree(v) > 1) res.push_back(v);
-
-    // One of the leaves should be included iff g is a ring.
-    // And if g is a ring, ilst_tree has two leaves and they are not g-independent.
-    if (const int nleaves{g.order() - static_cast<int>(res.size())}; nleaves == 2) {
-        int l1{0};
-        for (; l1 < ilst_tree.order(); ++l1)
-            if (ilst_tree.degree(l1) == 1) break;
+    std::vector<Strategy_spec> specs;
+    if (args.empty() || !parse_strategy_list(args.subspan(1), specs)) {
+        show_usage(cmd_name);
+        return EXIT_FAILURE;
+    }
 
-        int l2{l1 + 1};
-        for (; l2 < ilst_tree.order(); ++l2)
-            if (ilst_tree.degree(l2) == 1) break;
+    std::ios_base::sync_with_stdio(false);
+    if (std::strcmp(args[0], "-") == 0) return run_batch(std::cin, specs, std::cout) ? 0 : EXIT_FAILURE;
 
-        // if l1 and l2 are not g-independent, add l1 to the result
-        if (const auto& nn = g.neighbors(l1); std::ranges::find(nn, l2) != nn.cend())
-            res.push_back(l1);
+    std::ifstream manifest{args[0]};
+    if (!manifest) {
+        std::cerr << args[0] << ": cannot open file\n";
+        return EXIT_FAILURE;
     }
-
-    return res;
+    return run_batch(manifest, specs, std::cout) ? 0 : EXIT_FAILURE;
 }
 
-/// Checks if the `selection` of vertices forms a connected vertex cover of `g`.
-bool selection_is_cvc(const Simple_graph& g, const std::vector<int>& selection)
+/// Parses the options of the portfolio mode.  Returns false on an invalid or missing option value.
+bool parse_portfolio_options(std::span<const char* const> args, Portfolio_options& options)
 {
-    std::vector<bool> is_selected(g.order(), false);
-
-    // check if all edges are covered
-    std::set<std::pair<int, int>> covered;
-    for (const auto v : selection) {
-        is_selected[v] = true;
-        for (const auto u : g.neighbors(v))
-            covered.emplace(std::min(u, v), std::max(u, v));
-    }
-    if (std::ssize(covered) != g.size()) return false;
-
-    std::vector<bool> is_visited(g.order(), false);
-
-    // visit all vertices connected to root
-    // const std::function<void(const int)> visit_connected = [&](const int v) {
-    //     is_visited[v] = true;
-    //     for (const auto u : g.neighbors(v))
-    //         if (is_selected[u] && !is_visited[u]) visit_connected(u);
-    // };
-    const int root{*std::ranges::min_element(selection)};
-    // visit_connected(root);
-    std::vector<int> stack{root};
-    stack.reserve(g.order());
-    is_visited[root] = true;
-    while (!stack.empty()) {
-        const int v{stack.back()};
-        stack.pop_back();
-        for (const auto u : g.neighbors(v))
-            if (is_selected[u] && !is_visited[u]) {
-                is_visited[u] = true;
-                stack.push_back(u);
+    options.threads = std::max(1U, std::thread::hardware_concurrency());
+    try {
+        for (; args.size() >= 2 && args[0][0] == '-'; args = args.subspan(2)) {
+            const std::string value{args[1]};
+            std::size_t nparsed{0};
+            if (std::strcmp(args[0], "-j") == 0) {
+                const auto threads = std::stoul(value, &nparsed);
+                if (threads == 0) return false;
+                options.threads = static_cast<unsigned>(threads);
             }
+            else if (std::strcmp(args[0], "-n") == 0) {
+                options.perturbations = std::stoi(value, &nparsed);
+                if (options.perturbations < 0) return false;
+            }
+            else if (std::strcmp(args[0], "-t") == 0) {
+                options.time_limit = std::chrono::duration<double>{std::stod(value, &nparsed)};
+                if (options.time_limit.count() < 0) return false;
+            }
+            else if (std::strcmp(args[0], "-s") == 0) options.seed = std::stoull(value, &nparsed);
+            else return false;
+            if (nparsed != value.size()) return false;
+        }
+    }
+    catch (const std::logic_error&) {
+        return false;
     }
 
-    // if any vertex in selection is not visited, it's not connected to root and
-    // hence the selection of vertices is not connected
-    return std::ranges::all_of(selection, [&is_visited](const int v) { return is_visited[v]; });
+    if (args.empty()) {
+        options.specs = {{Ordering_strategy::dd, -1},
+                         {Ordering_strategy::sl, -1},
+                         {Ordering_strategy::sll, 1},
+                         {Ordering_strategy::sd, -1}};
+        return true;
+    }
+    return parse_strategy_list(args, options.specs);
 }
 
-void print_integers(const std::vector<int>& ints)
+/// Runs the dynamic mode on the command-line arguments following `--dynamic`: reads batches of
+/// edge updates (`+ u v` or `- u v`, each batch ended by a `.` or the end of the input) from the
+/// standard input and prints the connected vertex cover after each batch.
+int dynamic_main(const std::span<const char* const> args, const char* const cmd_name)
 {
-    for (unsigned i{0}; i < ints.size(); ++i) {
-        if (i != 0) std::cout << ' ';
-        std::cout << ints[i];
+    Strategy_spec spec{Ordering_strategy::sll, 1};
+    if ((args.size() != 2 && args.size() != 3) || !parse_strategy(args[1], spec.strategy) ||
+        (args.size() == 3 && spec.strategy != Ordering_strategy::sll)) {
+        show_usage(cmd_name);
+        return EXIT_FAILURE;
+    }
+    if (args.size() == 3 && (spec.r = parse_r(args[2])) == -1) {
+        std::cerr << "r must be in the range [1, " << r_limit << "]\n";
+        return EXIT_FAILURE;
+    }
+
+    std::optional<Dynamic_cvc> dynamic;
+    try {
+        const Csr_graph g{load_graph(args[0])};
+        if (g.order() <= 1) {
+            std::cerr << "Graph must have at least 2 vertices\n";
+            return EXIT_FAILURE;
+        }
+        dynamic.emplace(g, spec);
+    }
+    catch (const std::runtime_error& e) { // already names the file
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    catch (const std::exception& e) {
+        std::cerr << args[0] << ": " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    std::ios_base::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+    const auto emit = [&dynamic]() {
+        if (const auto cvc = dynamic->cover(); cvc.empty()) std::cout << "-1";
+        else print_integers(cvc);
+        std::cout << std::endl;
+    };
+
+    bool pending{false};
+    for (std::string op; std::cin >> op;) {
+        if (op == ".") {
+            emit();
+            pending = false;
+            continue;
+        }
+
+        int u{-1};
+        int v{-1};
+        if ((op != "+" && op != "-") || !(std::cin >> u >> v)) {
+            std::cerr << "Updates must be of the form `+ u v` or `- u v`\n";
+            return EXIT_FAILURE;
+        }
+        if (!(op == "+" ? dynamic->insert_edge(u, v) : dynamic->erase_edge(u, v)))
+            std::cerr << "Ignoring invalid update " << op << ' ' << u << ' ' << v << '\n';
+        pending = true;
     }
+    if (pending) emit();
+
+    return 0;
 }
 
-int main(const int argc, const char* const argv[])
+/// Runs the mode selected by the command-line arguments `args` (without `--stats`), recording its
+/// phases in `stats`.
+int run(const std::span<const char* const> args, Run_stats& stats)
 {
-    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (args.size() >= 2 && std::strcmp(args[1], "--batch") == 0) {
+        stats.phase("batch");
+        return batch_main(args.subspan(2), args[0]);
+    }
+    if (args.size() >= 2 && std::strcmp(args[1], "--dynamic") == 0) {
+        stats.phase("dynamic");
+        return dynamic_main(args.subspan(2), args[0]);
+    }
+
+    const bool use_portfolio{args.size() >= 2 && std::strcmp(args[1], "--portfolio") == 0};
+    Portfolio_options portfolio_options;
     Ordering_strategy strategy; // NOLINT(*-init-variables)
-    int r{-1};
+    int r{1};
 
-    if (argc == 3) {
-        if (std::strcmp(argv[1], "sll") != 0) {
-            show_usage(argv[0]);
+    if (use_portfolio) {
+        if (!parse_portfolio_options(args.subspan(2), portfolio_options)) {
+            show_usage(args[0]);
             return EXIT_FAILURE;
         }
-
-        try {
-            if (const unsigned long ul{std::stoul(argv[2])}; 1 <= ul && ul <= r_limit)
-                r = static_cast<int>(ul);
-        }
-        catch (const std::logic_error&) {
-            std::cerr << "r must be in the range [1, " << r_limit << "]\n";
+    }
+    else if (args.size() == 3) {
+        if (std::strcmp(args[1], "sll") != 0) {
+            show_usage(args[0]);
             return EXIT_FAILURE;
         }
+
+        r = parse_r(args[2]);
         if (r == -1) {
             std::cerr << "r must be in the range [1, " << r_limit << "]\n";
             return EXIT_FAILURE;
@@ -179,61 +214,57 @@ int main(const int argc, const char* const argv[])
 
         strategy = Ordering_strategy::sll;
     }
-    else if (argc == 2) {
-        if (std::strcmp(argv[1], "dd") == 0) strategy = Ordering_strategy::dd;
-        else if (std::strcmp(argv[1], "sl") == 0) strategy = Ordering_strategy::sl;
-        else if (std::strcmp(argv[1], "sd") == 0) strategy = Ordering_strategy::sd;
-        else if (std::strcmp(argv[1], "sll") == 0) {
-            strategy = Ordering_strategy::sll;
-            r = 1;
-        }
-        else {
-            show_usage(argv[0]);
-            return EXIT_FAILURE;
-        }
-    }
-    else {
-        show_usage(argv[0]);
+    else if (args.size() != 2 || !parse_strategy(args[1], strategy)) {
+        show_usage(args[0]);
         return EXIT_FAILURE;
     }
-    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-
-    // throw exceptions when input is of incorrect format
-    std::cin.exceptions(std::ios_base::failbit);
 
-    Simple_graph g(scan<int>());
+    stats.phase("read");
+    const Csr_graph g{read_graph(std::cin)};
     if (g.order() <= 1) {
         std::cerr << "Graph must have at least 2 vertices\n";
         return EXIT_FAILURE;
     }
-
-    for (auto m = scan<int>(); m-- != 0;)
-        g.add_edge(scan<int>(), scan<int>());
+    stats.phase("connectivity");
     if (!is_connected(g)) {
         std::cerr << "Graph must be connected\n";
         return EXIT_FAILURE;
     }
 
-    std::vector<int> ordering;
-    switch (strategy) {
-    case Ordering_strategy::dd:
-        ordering = descending_degree_ordering(g);
-        break;
-    case Ordering_strategy::sl:
-        ordering = smallest_last_ordering(g);
-        break;
-    case Ordering_strategy::sll:
-        ordering = smallest_log_last_ordering(g, r);
-        break;
-    case Ordering_strategy::sd:
-        ordering = saturation_degree_ordering(g);
-        break;
+    if (use_portfolio) {
+        stats.phase("portfolio");
+        const auto cvc_approx = portfolio_cvc(g, portfolio_options);
+        stats.phase("output");
+        if (cvc_approx.empty()) {
+            std::cout << "-1\n";
+            return EXIT_FAILURE;
+        }
+        print_integers(cvc_approx);
+        std::cout << '\n';
+        return 0;
     }
 
+    stats.phase("ordering");
+    std::vector<int> ordering{vertex_ordering(g, strategy, r)};
+
+    // the steps of `cvc_for_ordering()`, timed separately
+    Cvc_validator validator{g};
+    const auto approximate = [&](const char* const ilst_phase,
+                                 const char* const cover_phase,
+                                 const char* const validate_phase) {
+        stats.phase(ilst_phase);
+        const Simple_graph tree{ilst(g, ordering_to_priorities(ordering))};
+        stats.phase(cover_phase);
+        std::vector<int> cvc{cvc_from_ilst(g, tree)};
+        stats.phase(validate_phase);
+        if (!validator.check(cvc)) cvc.clear();
+        return cvc;
+    };
+
     // forward
-    Simple_graph ilst_tree{ilst(g, ordering_to_priorities(ordering))};
-    std::vector<int> cvc_approx{cvc_from_ilst(g, ilst_tree)};
-    if (!selection_is_cvc(g, cvc_approx)) {
+    std::vector<int> cvc_approx{approximate("ilst_fwd", "cover_fwd", "validate_fwd")};
+    stats.phase("output_fwd");
+    if (cvc_approx.empty()) {
         std::cout << "-1\n";
         return EXIT_FAILURE;
     }
@@ -242,11 +273,31 @@ int main(const int argc, const char* const argv[])
 
     // reverse
     std::ranges::reverse(ordering);
-    ilst_tree = ilst(g, ordering_to_priorities(ordering));
-    cvc_approx = cvc_from_ilst(g, ilst_tree);
-    if (!selection_is_cvc(g, cvc_approx)) return EXIT_FAILURE;
+    cvc_approx = approximate("ilst_rev", "cover_rev", "validate_rev");
+    stats.phase("output_rev");
+    if (cvc_approx.empty()) return EXIT_FAILURE;
     print_integers(cvc_approx);
     std::cout << '\n';
 
     return 0;
 }
+
+int main(const int argc, const char* const argv[])
+{
+    std::vector<const char*> args(argv, argv + argc);
+    const bool show_stats{args.size() >= 2 && std::strcmp(args[1], "--stats") == 0};
+    if (show_stats) args.erase(args.begin() + 1);
+
+    Run_stats stats{show_stats};
+    int status{EXIT_FAILURE};
+    try {
+        status = run(args, stats);
+    }
+    catch (const std::exception& e) { // e.g. a malformed graph on the standard input
+        std::cerr << args[0] << ": " << e.what() << '\n';
+    }
+    stats.stop();
+    std::cout.flush();
+    stats.print(std::cerr);
+    return status;
+}
@@ -0,0 +1,75 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#include "options.h"
+
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ordering.h"
+
+bool parse_strategy(const std::string_view name, Ordering_strategy& strategy)
+{
+    if (name == "dd") strategy = Ordering_strategy::dd;
+    else if (name == "sl") strategy = Ordering_strategy::sl;
+    else if (name == "sll") strategy = Ordering_strategy::sll;
+    else if (name == "sd") strategy = Ordering_strategy::sd;
+    else return false;
+    return true;
+}
+
+int parse_r(const char* const arg)
+{
+    try {
+        std::size_t nparsed{0};
+        const std::string str{arg};
+        if (const unsigned long ul{std::stoul(str, &nparsed)};
+            nparsed == str.size() && 1 <= ul && ul <= r_limit)
+            return static_cast<int>(ul);
+    }
+    catch (const std::logic_error&) {
+    }
+    return -1;
+}
+
+std::string_view strategy_name(const Ordering_strategy strategy)
+{
+    switch (strategy) {
+    case Ordering_strategy::dd:
+        return "dd";
+    case Ordering_strategy::sl:
+        return "sl";
+    case Ordering_strategy::sll:
+        return "sll";
+    case Ordering_strategy::sd:
+        return "sd";
+    }
+    return "";
+}
+
+bool parse_strategy_list(const std::span<const char* const> args, std::vector<Strategy_spec>& specs)
+{
+    for (std::size_t i{0}; i < args.size(); ++i) {
+        Ordering_strategy strategy; // NOLINT(*-init-variables)
+        if (!parse_strategy(args[i], strategy)) return false;
+        if (strategy != Ordering_strategy::sll) {
+            specs.push_back({strategy, -1});
+            continue;
+        }
+
+        bool has_r{false};
+        for (Ordering_strategy next; // NOLINT(*-init-variables)
+             i + 1 < args.size() && !parse_strategy(args[i + 1], next);
+             ++i) {
+            const int r{parse_r(args[i + 1])};
+            if (r == -1) return false;
+            specs.push_back({Ordering_strategy::sll, r});
+            has_r = true;
+        }
+        if (!has_r) specs.push_back({Ordering_strategy::sll, 1});
+    }
+    return !specs.empty();
+}
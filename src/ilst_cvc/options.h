@@ -0,0 +1,36 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef OPTIONS_H_INCLUDED
+#define OPTIONS_H_INCLUDED
+
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "ordering.h"
+
+constexpr int r_limit{32};
+
+/// An ordering heuristic together with its parameter.
+struct Strategy_spec {
+    Ordering_strategy strategy;
+    int r; ///< the r parameter of sll; unused by the other heuristics
+};
+
+/// Parses the name of an ordering heuristic (`dd`, `sl`, `sll` or `sd`).
+/// Returns false iff `name` is not one of them.
+bool parse_strategy(std::string_view name, Ordering_strategy& strategy);
+
+/// Parses the r parameter of sll.  Returns -1 iff `arg` is not an integer in [1, `r_limit`].
+int parse_r(const char* const arg);
+
+/// Returns the command-line name of `strategy`.
+std::string_view strategy_name(const Ordering_strategy strategy);
+
+/// Parses a list of heuristics such as `dd sll 1 4 sd`, where `sll` takes any number of r values
+/// (1 if none is given) and adds one spec per value.  Returns false on an unknown heuristic or an
+/// invalid r.
+bool parse_strategy_list(std::span<const char* const> args, std::vector<Strategy_spec>& specs);
+
+#endif // OPTIONS_H_INCLUDED
@@ -4,16 +4,16 @@
 #include "ordering.h"
 
 #include <algorithm>
-#include <iterator>
+#include <bit>
 #include <numeric>
-#include <set>
 #include <tuple>
 #include <utility>
 #include <vector>
 
-#include "simple_graph.h"
+#include "csr_graph.h"
+#include "vertex_queue.h"
 
-std::vector<int> descending_degree_ordering(const Simple_graph& g)
+std::vector<int> descending_degree_ordering(const Csr_graph& g)
 {
     std::vector<int> res(g.order());
     std::iota(res.begin(), res.end(), 0);
@@ -23,66 +23,60 @@ std::vector<int> descending_degree_ordering(const Simple_graph& g)
     return res;
 }
 
-std::vector<int> smallest_last_ordering(const Simple_graph& g)
+std::vector<int> smallest_last_ordering(const Csr_graph& g)
 {
     std::vector<int> degree(g.order());
+    for (int v{0}; v < g.order(); ++v)
+        degree[v] = g.degree(v);
     const auto cmp = [&](const int u, const int v) -> bool {
         return std::make_pair(degree[u], u) < std::make_pair(degree[v], v);
     };
-    std::set<int, decltype(cmp)> todo{cmp};
-    for (int v{0}; v < g.order(); ++v) {
-        degree[v] = g.degree(v);
-        todo.insert(v);
-    }
+    Vertex_queue todo{g.order(), cmp};
 
     std::vector<int> res(g.order(), -1);
     int index{g.order() - 1};
     while (!todo.empty()) {
-        const int v{*todo.cbegin()};
-        todo.erase(todo.begin());
+        const int v{todo.top()};
+        todo.pop();
         res[index--] = v;
 
         for (const auto u : g.neighbors(v)) {
-            const auto itr = todo.find(u);
-            if (itr == todo.cend()) continue;
+            if (!todo.contains(u)) continue;
 
-            todo.erase(itr);
             --degree[u];
-            todo.insert(u);
+            todo.update(u);
         }
     }
 
     return res;
 }
 
-std::vector<int> smallest_log_last_ordering(const Simple_graph& g, const int max_rounds)
+std::vector<int> smallest_log_last_ordering(const Csr_graph& g, const int max_rounds)
 {
-    std::vector<std::set<int>> adj(g.order());
+    /// The numbers of neighbors not yet placed in the ordering
+    std::vector<int> degree(g.order());
+    for (int v{0}; v < g.order(); ++v)
+        degree[v] = g.degree(v);
     const auto cmp = [&](const int u, const int v) -> bool {
-        return std::make_pair(adj[u].size(), u) < std::make_pair(adj[v].size(), v);
+        return std::make_pair(degree[u], u) < std::make_pair(degree[v], v);
     };
-    std::set<int, decltype(cmp)> todo{cmp};
-    for (int v{0}; auto&& neighs : g.adj_data()) {
-        adj[v] = std::set<int>(std::make_move_iterator(neighs.begin()),
-                               std::make_move_iterator(neighs.end()));
-        todo.insert(v);
-        ++v;
-    }
+    Vertex_queue todo{g.order(), cmp};
 
     std::vector<int> res(g.order(), -1);
     int index{g.order() - 1};
     for (unsigned d{0}; index >= 0 && !todo.empty(); ++d) {
         for (int round{0}; round < max_rounds && !todo.empty(); ++round) {
-            const int v{*todo.cbegin()};
-            if (std::bit_ceil(adj[v].size()) > d) break;
+            const int v{todo.top()};
+            if (std::bit_ceil(static_cast<unsigned>(degree[v])) > d) break;
 
-            todo.erase(todo.begin());
+            todo.pop();
             res[index--] = v;
 
-            for (const auto u : adj[v]) {
-                todo.erase(u);
-                adj[u].erase(v);
-                todo.insert(u);
+            for (const auto u : g.neighbors(v)) {
+                if (!todo.contains(u)) continue;
+
+                --degree[u];
+                todo.update(u);
             }
         }
     }
@@ -90,23 +84,54 @@ std::vector<int> smallest_log_last_ordering(const Simple_graph& g, const int max
     return res;
 }
 
-std::vector<int> saturation_degree_ordering(const Simple_graph& g)
+std::vector<int> saturation_degree_ordering(const Csr_graph& g)
 {
-    /// The sets of colors used by neighbors
-    /// (`adj_colors[v]` == v.adjColors in the paper's notation)
-    std::vector<std::set<int>> adj_colors(g.order());
+    const auto offsets = g.offsets();
+
+    /// The colors assigned so far (-1 for uncolored vertices)
+    std::vector<int> color(g.order(), -1);
+
+    /// The numbers of distinct colors used by neighbors
+    /// (`saturation[v]` == |v.adjColors| in the paper's notation)
+    std::vector<int> saturation(g.order(), 0);
+
+    /// The numbers of uncolored neighbors
+    /// (`nuncolored[v]` == |v.adjUncolored| in the paper's notation)
+    std::vector<int> nuncolored(g.order());
+
+    /// Whether a neighbor of `v` uses color `c`, for every `c` in [0, degree(v)], stored at
+    /// `offsets[v] + v + c`.  A vertex never needs a color above its degree, so these flags are
+    /// enough to find the smallest available color.
+    std::vector<bool> has_color(offsets.back() + g.order(), false);
+
+    /// The neighbor colors above `degree(v)`, stored from `offsets[v]`, and their counts.  They
+    /// still count towards the saturation degree, but are rare enough to be searched linearly.
+    std::vector<int> high_colors(offsets.back());
+    std::vector<int> nhigh_colors(g.order(), 0);
+
+    /// Records that a neighbor of the uncolored vertex `v` got the color `c`.
+    const auto add_adj_color = [&](const int v, const int c) {
+        if (c <= g.degree(v)) {
+            if (auto flag = has_color[offsets[v] + v + c]; !flag) {
+                flag = true;
+                ++saturation[v];
+            }
+            return;
+        }
 
-    /// The sets of uncolored neighbors
-    /// (`adj_uncolored[v]` == v.adjUncolored in the paper's notation)
-    std::vector<std::set<int>> adj_uncolored(g.order());
+        const auto first = high_colors.begin() + offsets[v];
+        const auto last = first + nhigh_colors[v];
+        if (std::find(first, last, c) == last) {
+            high_colors[offsets[v] + nhigh_colors[v]++] = c;
+            ++saturation[v];
+        }
+    };
 
     const auto smallest_available_color = [&](const int v) -> int {
-        int prev = -1;
-        for (const auto curr : adj_colors[v]) {
-            if (prev + 1 != curr) break;
-            prev = curr;
-        }
-        return prev + 1;
+        int c{0};
+        while (has_color[offsets[v] + v + c])
+            ++c;
+        return c;
     };
 
     /// Comparator for sorting vertices
@@ -116,18 +141,14 @@ std::vector<int> saturation_degree_ordering(const Simple_graph& g)
     ///   3. then in decreasing order of degrees (|v.adj|),
     ///   4. and finally in incresing order of v
     const auto cmp = [&](const int u, const int v) -> bool {
-        return std::make_tuple(adj_colors[u].size(), adj_uncolored[u].size(), g.degree(u), v) >
-               std::make_tuple(adj_colors[v].size(), adj_uncolored[v].size(), g.degree(v), u);
+        return std::make_tuple(saturation[u], nuncolored[u], g.degree(u), v) >
+               std::make_tuple(saturation[v], nuncolored[v], g.degree(v), u);
     };
-    std::set<int, decltype(cmp)> uncolored{cmp};
 
     // Initialize the data structures. [Lines 39-40 of the paper's pseudocode]
-    for (int v{0}; auto&& neighs : g.adj_data()) {
-        adj_uncolored[v] = std::set<int>(std::make_move_iterator(neighs.begin()),
-                                         std::make_move_iterator(neighs.end()));
-        uncolored.insert(v);
-        ++v;
-    }
+    for (int v{0}; v < g.order(); ++v)
+        nuncolored[v] = g.degree(v);
+    Vertex_queue uncolored{g.order(), cmp};
 
     std::vector<int> res(g.order(), -1);
     int index{0};
@@ -135,21 +156,38 @@ std::vector<int> saturation_degree_ordering(const Simple_graph& g)
     // The main loop [Lines 42-52 of the paper's pseudocode]
     while (!uncolored.empty()) {
         // [Line 43]
-        const int v{*uncolored.begin()};
-        uncolored.erase(uncolored.begin());
+        const int v{uncolored.top()};
+        uncolored.pop();
         res[index++] = v;
 
         // [Line 44]
         const int c{smallest_available_color(v)};
+        color[v] = c;
 
         // [Lines 45-50: the for loop]
-        for (const auto u : adj_uncolored[v]) {
-            uncolored.erase(u);        // [Line 46]
-            adj_colors[u].insert(c);   // [Line 47]
-            adj_uncolored[u].erase(v); // [Line 48]
-            uncolored.insert(u);       // [Line 49]
+        for (const auto u : g.neighbors(v)) {
+            if (color[u] != -1) continue;
+
+            add_adj_color(u, c); // [Line 47]
+            --nuncolored[u];     // [Line 48]
+            uncolored.update(u); // [Lines 46 and 49]
         }
     }
 
     return res;
 }
+
+std::vector<int> vertex_ordering(const Csr_graph& g, const Ordering_strategy strategy, const int r)
+{
+    switch (strategy) {
+    case Ordering_strategy::dd:
+        return descending_degree_ordering(g);
+    case Ordering_strategy::sl:
+        return smallest_last_ordering(g);
+    case Ordering_strategy::sll:
+        return smallest_log_last_ordering(g, r);
+    case Ordering_strategy::sd:
+        return saturation_degree_ordering(g);
+    }
+    return {};
+}
@@ -4,13 +4,20 @@
 #ifndef ORDERING_H_INCLUDED
 #define ORDERING_H_INCLUDED
 
+#include <cstdint>
 #include <vector>
 
-#include "simple_graph.h"
+#include "csr_graph.h"
 
-std::vector<int> descending_degree_ordering(const Simple_graph& g);
-std::vector<int> smallest_last_ordering(const Simple_graph& g);
-std::vector<int> smallest_log_last_ordering(const Simple_graph& g, const int max_rounds);
-std::vector<int> saturation_degree_ordering(const Simple_graph& g);
+enum class Ordering_strategy : std::uint8_t { dd, sl, sll, sd };
+
+std::vector<int> descending_degree_ordering(const Csr_graph& g);
+std::vector<int> smallest_last_ordering(const Csr_graph& g);
+std::vector<int> smallest_log_last_ordering(const Csr_graph& g, const int max_rounds);
+std::vector<int> saturation_degree_ordering(const Csr_graph& g);
+
+/// Returns the ordering of the vertices of `g` produced by `strategy`; `r` is used only by
+/// `Ordering_strategy::sll`, as its `max_rounds`.
+std::vector<int> vertex_ordering(const Csr_graph& g, const Ordering_strategy strategy, const int r);
 
 #endif // ORDERING_H_INCLUDED
@@ -0,0 +1,113 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#include "portfolio.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.h"
+#include "cvc.h"
+#include "options.h"
+#include "ordering.h"
+
+/// Returns a copy of `g` in which every vertex `v` is renamed to `label[v]`; `original` must be the
+/// inverse permutation of `label`.
+static Csr_graph relabeled(const Csr_graph& g,
+                           const std::vector<int>& label,
+                           const std::vector<int>& original)
+{
+    std::vector<int> offsets{0};
+    std::vector<int> targets;
+    offsets.reserve(static_cast<std::size_t>(g.order()) + 1);
+    targets.reserve(g.targets().size());
+    for (const auto v : original) {
+        for (const auto u : g.neighbors(v))
+            targets.push_back(label[static_cast<std::size_t>(u)]);
+        offsets.push_back(static_cast<int>(targets.size()));
+    }
+    return Csr_graph{std::move(offsets), std::move(targets)};
+}
+
+/// Returns the ordering of `g` produced by `spec`, with ties broken by a random permutation of the
+/// vertices instead of by their numbers if `perturbation` is non-zero.  All the heuristics break
+/// ties in favor of smaller vertex numbers, so running them on a randomly relabeled copy of `g`
+/// randomizes exactly their tie-breaking.
+static std::vector<int> perturbed_ordering(const Csr_graph& g,
+                                           const Strategy_spec& spec,
+                                           const int perturbation,
+                                           const std::uint64_t seed)
+{
+    if (perturbation == 0) return vertex_ordering(g, spec.strategy, spec.r);
+
+    std::seed_seq seq{seed, static_cast<std::uint64_t>(perturbation)};
+    std::mt19937_64 rng{seq};
+    const auto n = static_cast<std::size_t>(g.order());
+    std::vector<int> label(n);
+    std::iota(label.begin(), label.end(), 0);
+    std::ranges::shuffle(label, rng);
+
+    std::vector<int> original(n);
+    for (std::size_t v{0}; v < n; ++v)
+        original[static_cast<std::size_t>(label[v])] = static_cast<int>(v);
+
+    auto ordering = vertex_ordering(relabeled(g, label, original), spec.strategy, spec.r);
+    for (auto& v : ordering)
+        v = original[static_cast<std::size_t>(v)];
+    return ordering;
+}
+
+std::vector<int> portfolio_cvc(const Csr_graph& g, const Portfolio_options& options)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    const auto out_of_time = [&]() -> bool { return Clock::now() - start >= options.time_limit; };
+
+    const auto nruns = options.specs.size() * static_cast<std::size_t>(options.perturbations + 1);
+    std::atomic<std::size_t> next_run{0};
+    std::atomic<bool> found{false};
+
+    std::mutex best_mutex;
+    std::vector<int> best;
+    std::size_t best_index{0}; ///< the index of the run-direction pair that found `best`
+
+    const auto offer = [&](std::vector<int>&& cvc, const std::size_t index) {
+        if (cvc.empty()) return;
+        const std::scoped_lock lock{best_mutex};
+        if (best.empty() || std::make_pair(cvc.size(), index) < std::make_pair(best.size(), best_index)) {
+            best = std::move(cvc);
+            best_index = index;
+        }
+        found = true;
+    };
+
+    const auto worker = [&]() {
+        Cvc_validator validator{g};
+        for (std::size_t i{next_run++}; i < nruns && !(found && out_of_time()); i = next_run++) {
+            const auto& spec = options.specs[i / static_cast<std::size_t>(options.perturbations + 1)];
+            const auto perturbation = static_cast<int>(i % static_cast<std::size_t>(options.perturbations + 1));
+
+            auto ordering = perturbed_ordering(g, spec, perturbation, options.seed);
+            offer(cvc_for_ordering(validator, ordering), 2 * i);
+            std::ranges::reverse(ordering);
+            offer(cvc_for_ordering(validator, ordering), 2 * i + 1);
+        }
+    };
+
+    {
+        std::vector<std::jthread> pool;
+        for (unsigned t{1}; t < options.threads; ++t)
+            pool.emplace_back(worker);
+        worker();
+    }
+
+    return best;
+}
@@ -0,0 +1,31 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef PORTFOLIO_H_INCLUDED
+#define PORTFOLIO_H_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "csr_graph.h"
+#include "options.h"
+
+struct Portfolio_options {
+    std::vector<Strategy_spec> specs; ///< the heuristics to run
+    int perturbations{0};             ///< number of randomly tie-broken runs per heuristic
+    unsigned threads{1};              ///< number of worker threads
+    std::chrono::duration<double> time_limit{std::chrono::duration<double>::max()};
+    std::uint64_t seed{0};            ///< seed of the random tie-breaking
+};
+
+/// Runs every heuristic in `options.specs`, once as is and `options.perturbations` times with ties
+/// broken randomly, in both directions, on `options.threads` threads, and returns the smallest
+/// connected vertex cover of `g` found that passed validation (or an empty vector if none did).
+///
+/// No new run is started once `options.time_limit` has passed and a cover has been found.  Among
+/// covers of equal size, the one from the earliest run (in the above order, forward before reverse)
+/// is returned, so the result only depends on the options if every run completes.
+std::vector<int> portfolio_cvc(const Csr_graph& g, const Portfolio_options& options);
+
+#endif // PORTFOLIO_H_INCLUDED
@@ -0,0 +1,79 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef VERTEX_QUEUE_H_INCLUDED
+#define VERTEX_QUEUE_H_INCLUDED
+
+#include <bit>
+#include <cstddef>
+#include <vector>
+
+/// A priority queue of the vertices [0, n) laid out as a flat tournament tree: every leaf is a
+/// vertex and every inner node holds the better of its two children according to `Cmp`, so the
+/// root is the front of the queue.  `Cmp(u, v)` must return true iff `u` comes before `v`; it is
+/// expected to read the vertices' keys from state owned by the caller, who must call `update()`
+/// after changing the key of a queued vertex.
+///
+/// Unlike a `std::set` with the same comparator, nothing is allocated after construction and a key
+/// change costs a single leaf-to-root pass instead of an erase and an insert.
+template<typename Cmp>
+class Vertex_queue {
+public:
+    /// Queues all the vertices [0, `n`).
+    /// Time complexity: O(n)
+    Vertex_queue(const int n, Cmp cmp) :
+        _leaves{std::bit_ceil(static_cast<std::size_t>(n))}, _tree(2 * _leaves, none), _cmp{cmp}
+    {
+        for (int v{0}; v < n; ++v)
+            _tree[_leaves + static_cast<std::size_t>(v)] = v;
+        for (std::size_t i{_leaves - 1}; i > 0; --i)
+            _tree[i] = better(_tree[2 * i], _tree[2 * i + 1]);
+    }
+
+    [[nodiscard]] bool empty() const { return _tree[1] == none; }
+
+    /// Returns the vertex at the front of the queue; the queue must not be empty.
+    [[nodiscard]] int top() const { return _tree[1]; }
+
+    /// Returns true iff `v` has not been popped or erased.
+    [[nodiscard]] bool contains(const int v) const { return _tree[leaf(v)] != none; }
+
+    /// Removes `v` from the queue.
+    /// Time complexity: O(log n)
+    void erase(const int v)
+    {
+        _tree[leaf(v)] = none;
+        sift_up(leaf(v));
+    }
+
+    /// Removes the vertex at the front of the queue.
+    void pop() { erase(top()); }
+
+    /// Restores the queue order after the key of the queued vertex `v` has changed.
+    /// Time complexity: O(log n)
+    void update(const int v) { sift_up(leaf(v)); }
+
+private:
+    static constexpr int none{-1};
+
+    std::size_t _leaves;    ///< number of leaves, a power of 2
+    std::vector<int> _tree; ///< the implicit binary tree; node `i` has children `2i` and `2i + 1`
+    Cmp _cmp;
+
+    [[nodiscard]] std::size_t leaf(const int v) const { return _leaves + static_cast<std::size_t>(v); }
+
+    [[nodiscard]] int better(const int u, const int v) const
+    {
+        if (u == none) return v;
+        if (v == none) return u;
+        return _cmp(v, u) ? v : u;
+    }
+
+    void sift_up(std::size_t i)
+    {
+        for (i /= 2; i > 0; i /= 2)
+            _tree[i] = better(_tree[2 * i], _tree[2 * i + 1]);
+    }
+};
+
+#endif // VERTEX_QUEUE_H_INCLUDED
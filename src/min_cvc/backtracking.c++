@@ -1,82 +1,335 @@
 #include "backtracking.h"
 
 #include <algorithm>
-#include <iterator>
-#include <set>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <thread>
 #include <utility>
 #include <vector>
 
-std::pair<int, int> make_edge(int u, int v)
+#include "csr_graph.h"
+
+using Word = std::uint64_t;
+constexpr std::size_t word_bits{64};
+constexpr Word one_word{1};
+
+/// Calls `f(v)` for every set bit `v` of `bits`, in increasing order.
+template<typename F> void for_each_bit(const std::span<const Word> bits, F f)
 {
-    return std::make_pair(std::min(u, v), std::max(u, v));
+    for (std::size_t w{0}; w < bits.size(); ++w)
+        for (Word word{bits[w]}; word != 0; word &= word - 1)
+            f(static_cast<int>(w * word_bits + static_cast<std::size_t>(std::countr_zero(word))));
 }
 
-int recur(const Simple_graph& g, // NOLINT(misc-no-recursion)
-          std::set<std::pair<int, int>>& covered,
-          std::set<int>& candidates,
-          std::set<int>& taken)
-{
-    if (std::ssize(covered) == g.size()) return static_cast<int>(taken.size());
-
-    std::set<int> min_cvc;
-    int min_cardinality{g.order()};
-    while (!candidates.empty()) {
-        const int v{*candidates.begin()};
-        candidates.erase(candidates.begin());
-
-        std::vector<int> newly_covered;
-        for (const auto u : g.neighbors(v)) {
-            candidates.insert(u);
-            if (const auto& [_, is_new] = covered.emplace(make_edge(u, v)); is_new)
-                newly_covered.push_back(u);
+/// Branch-and-bound search for a minimum connected vertex cover.
+///
+/// A search node decides some vertices to be in the cover (`in`) and some to be out of it (`out`);
+/// every neighbor of an `out` vertex is `in`, so the only uncovered edges are those between two
+/// undecided vertices.  A node is pruned if
+///   - `in` cannot be connected through undecided vertices, or
+///   - |`in`| plus the size of a greedy maximal matching of the uncovered edges (each of which needs
+///     its own cover vertex) is not below the size of the best cover found so far.
+/// Otherwise a vertex is branched on, first taking it and then leaving it (and hence taking all its
+/// neighbors) out.  All the vertex sets are bitsets of `_words` words.
+class Branch_and_bound {
+public:
+    explicit Branch_and_bound(const Csr_graph& g) :
+        _n{g.order()}, _words{(static_cast<std::size_t>(g.order()) + word_bits - 1) / word_bits}
+    {
+        _adj.assign(static_cast<std::size_t>(_n) * _words, 0);
+        for (int v{0}; v < _n; ++v)
+            for (const auto u : g.neighbors(v))
+                set_bit(row(v), u);
+
+        _all.assign(_words, 0);
+        for (int v{0}; v < _n; ++v)
+            set_bit(_all, v);
+
+        _best_size = _n + 1;
+        seed_incumbent(g);
+    }
+
+    std::vector<int> solve(const unsigned threads)
+    {
+        if (_best_size > _n) return {}; // the edges are not all in one component
+
+        Worker main_worker{*this};
+        // first split the search tree into enough subtrees to keep every thread busy
+        _split_depth = threads > 1 ? static_cast<int>(std::bit_width(8 * threads)) : 0;
+        search(main_worker, 0);
+
+        std::atomic<std::size_t> next_task{0};
+        const auto work = [&]() {
+            Worker worker{*this};
+            for (std::size_t i{next_task++}; i < _tasks.size(); i = next_task++) {
+                std::ranges::copy(_tasks[i], worker.in(0).begin());
+                search(worker, 0);
+            }
+        };
+        _split_depth = -1;
+        {
+            std::vector<std::jthread> pool;
+            for (unsigned t{1}; t < threads; ++t)
+                pool.emplace_back(work);
+            work();
         }
 
-        if (const int c{recur(g, covered, candidates, taken)}; c < min_cardinality) {
-            min_cardinality = c;
-            min_cvc = taken;
+        std::vector<int> res;
+        for_each_bit(_best, [&](const int v) { res.push_back(v); });
+        return res;
+    }
+
+private:
+    /// Per-thread storage: the `in` and `out` sets of the nodes on the current search path, indexed
+    /// by depth, and scratch bitsets.
+    struct Worker {
+        std::size_t words;
+        std::vector<Word> path;
+        std::vector<Word> reached, frontier, next, allowed, matched, undecided;
+
+        explicit Worker(const Branch_and_bound& bnb) :
+            words{bnb._words},
+            path(2 * (static_cast<std::size_t>(bnb._n) + 2) * bnb._words),
+            reached(bnb._words),
+            frontier(bnb._words),
+            next(bnb._words),
+            allowed(bnb._words),
+            matched(bnb._words),
+            undecided(bnb._words)
+        {
         }
-        taken.insert(v);
-        if (const int c{recur(g, covered, candidates, taken)}; c < min_cardinality) {
-            min_cardinality = c;
-            min_cvc = taken;
+
+        std::span<Word> in(const int depth)
+        {
+            return std::span{path}.subspan(2 * static_cast<std::size_t>(depth) * words, words);
+        }
+        std::span<Word> out(const int depth)
+        {
+            return std::span{path}.subspan((2 * static_cast<std::size_t>(depth) + 1) * words, words);
         }
-        taken.erase(v);
+    };
+
+    int _n;
+    std::size_t _words;
+    std::vector<Word> _adj; ///< the adjacency bitsets, `_words` words per vertex
+    std::vector<Word> _all; ///< the set of all vertices
 
-        for (const auto u : newly_covered)
-            covered.erase(make_edge(u, v));
+    std::atomic<int> _best_size;
+    std::mutex _best_mutex;
+    std::vector<Word> _best;
+
+    int _split_depth{-1};                ///< the depth at which nodes become tasks (-1: never)
+    std::vector<std::vector<Word>> _tasks; ///< the `in` and `out` sets of the subtrees to search
+
+    static void set_bit(const std::span<Word> bits, const int v)
+    {
+        bits[static_cast<std::size_t>(v) / word_bits] |= one_word << (static_cast<std::size_t>(v) % word_bits);
+    }
+    static bool test_bit(const std::span<const Word> bits, const int v)
+    {
+        return ((bits[static_cast<std::size_t>(v) / word_bits] >> (static_cast<std::size_t>(v) % word_bits)) & one_word) != 0;
+    }
+    static int count(const std::span<const Word> bits)
+    {
+        int res{0};
+        for (const auto word : bits)
+            res += std::popcount(word);
+        return res;
     }
 
-    taken = min_cvc;
-    return static_cast<int>(taken.size());
-}
+    std::span<Word> row(const int v)
+    {
+        return std::span{_adj}.subspan(static_cast<std::size_t>(v) * _words, _words);
+    }
+    [[nodiscard]] std::span<const Word> row(const int v) const
+    {
+        return std::span{_adj}.subspan(static_cast<std::size_t>(v) * _words, _words);
+    }
 
-std::set<int> find_cvc_by_backtracking(const Simple_graph& g)
-{
-    std::set<int> best;
-    int best_cardinality{g.order()};
-    std::set<int> taken;
-    std::set<int> candidates;
-    std::set<std::pair<int, int>> covered;
-    for (int v{0}; v < g.order(); ++v) {
-        std::vector<int> newly_covered;
-        for (const auto u : g.neighbors(v)) {
-            candidates.insert(u);
-            if (covered.emplace(make_edge(u, v)).second) newly_covered.push_back(u);
+    /// Starts from the root and the inner vertices of a DFS tree of the component holding the edges,
+    /// which form a connected vertex cover: the other leaves of a DFS tree are never adjacent.
+    /// Leaves `_best_size` above `_n` if the edges span several components.
+    void seed_incumbent(const Csr_graph& g)
+    {
+        int root{0};
+        while (root < _n && g.degree(root) == 0)
+            ++root;
+        if (root == _n) { // no edges: the empty set is a cover
+            _best.assign(_words, 0);
+            _best_size = 0;
+            return;
         }
 
-        if (const int c{recur(g, covered, candidates, taken)}; c < best_cardinality) {
-            best = taken;
-            best_cardinality = c;
+        const auto n = static_cast<std::size_t>(_n);
+        std::vector<int> tree_degree(n, 0);
+        std::vector<bool> is_visited(n, false);
+        std::vector<std::pair<int, std::size_t>> stack{{root, 0}};
+        is_visited[static_cast<std::size_t>(root)] = true;
+        while (!stack.empty()) {
+            auto& [v, offset] = stack.back();
+            const auto neighs = g.neighbors(v);
+            while (offset < neighs.size() && is_visited[static_cast<std::size_t>(neighs[offset])])
+                ++offset;
+            if (offset == neighs.size()) {
+                stack.pop_back();
+                continue;
+            }
+            const int u{neighs[offset]};
+            is_visited[static_cast<std::size_t>(u)] = true;
+            ++tree_degree[static_cast<std::size_t>(v)];
+            ++tree_degree[static_cast<std::size_t>(u)];
+            stack.emplace_back(u, 0);
         }
-        taken.insert(v);
-        if (const int c{recur(g, covered, candidates, taken)}; c < best_cardinality) {
-            best = taken;
-            best_cardinality = c;
+        for (std::size_t v{0}; v < n; ++v)
+            if (g.degree(static_cast<int>(v)) != 0 && !is_visited[v]) return;
+
+        _best.assign(_words, 0);
+        set_bit(_best, root);
+        for (std::size_t v{0}; v < n; ++v)
+            if (tree_degree[v] >= 2) set_bit(_best, static_cast<int>(v));
+        _best_size = count(_best);
+    }
+
+    /// Computes in `worker.reached` the vertices reachable from `source` within `allowed`.
+    void reach(Worker& worker, const int source, const std::span<const Word> allowed) const
+    {
+        std::ranges::fill(worker.reached, Word{0});
+        std::ranges::fill(worker.frontier, Word{0});
+        set_bit(worker.reached, source);
+        set_bit(worker.frontier, source);
+        for (bool grew{true}; grew;) {
+            std::ranges::fill(worker.next, Word{0});
+            for_each_bit(worker.frontier, [&](const int v) {
+                const auto neighs = row(v);
+                for (std::size_t w{0}; w < _words; ++w)
+                    worker.next[w] |= neighs[w];
+            });
+            grew = false;
+            for (std::size_t w{0}; w < _words; ++w) {
+                worker.frontier[w] = worker.next[w] & allowed[w] & ~worker.reached[w];
+                worker.reached[w] |= worker.frontier[w];
+                grew = grew || worker.frontier[w] != 0;
+            }
         }
-        taken.erase(v);
+    }
+
+    /// Returns true iff `reached` contains all of `bits`.
+    static bool covers(const std::span<const Word> reached, const std::span<const Word> bits)
+    {
+        for (std::size_t w{0}; w < bits.size(); ++w)
+            if ((bits[w] & ~reached[w]) != 0) return false;
+        return true;
+    }
 
-        for (const auto u : newly_covered)
-            covered.erase(make_edge(u, v));
+    /// Returns the size of a greedy maximal matching among the undecided vertices.
+    int matching_size(Worker& worker) const
+    {
+        std::ranges::fill(worker.matched, Word{0});
+        int size{0};
+        for_each_bit(worker.undecided, [&](const int v) {
+            if (test_bit(worker.matched, v)) return;
+            const auto neighs = row(v);
+            for (std::size_t w{0}; w < _words; ++w) {
+                if (const Word free{neighs[w] & worker.undecided[w] & ~worker.matched[w]}; free != 0) {
+                    worker.matched[w] |= free & -free;
+                    set_bit(worker.matched, v);
+                    ++size;
+                    return;
+                }
+            }
+        });
+        return size;
     }
-    return best;
+
+    void record(const std::span<const Word> in, const int size)
+    {
+        const std::scoped_lock lock{_best_mutex};
+        if (size >= _best_size) return;
+        _best.assign(in.begin(), in.end());
+        _best_size = size;
+    }
+
+    void search(Worker& worker, const int depth) // NOLINT(misc-no-recursion)
+    {
+        const auto in = worker.in(depth);
+        const auto out = worker.out(depth);
+        const int nin{count(in)};
+        if (nin >= _best_size) return;
+
+        if (depth == _split_depth) {
+            _tasks.emplace_back(in.begin(), in.end());
+            _tasks.back().insert(_tasks.back().end(), out.begin(), out.end());
+            return;
+        }
+
+        for (std::size_t w{0}; w < _words; ++w)
+            worker.undecided[w] = _all[w] & ~in[w] & ~out[w];
+
+        // `in` must lie in one component of the graph induced by `in` and the undecided vertices
+        bool in_is_connected{true};
+        int in_root{-1};
+        for (std::size_t w{0}; w < _words && in_root == -1; ++w)
+            if (in[w] != 0) in_root = static_cast<int>(w * word_bits + static_cast<std::size_t>(std::countr_zero(in[w])));
+        if (in_root != -1) {
+            reach(worker, in_root, in);
+            in_is_connected = covers(worker.reached, in);
+            if (!in_is_connected) {
+                for (std::size_t w{0}; w < _words; ++w)
+                    worker.allowed[w] = in[w] | worker.undecided[w];
+                reach(worker, in_root, worker.allowed);
+                if (!covers(worker.reached, in)) return;
+            }
+        }
+
+        const int nuncovered_lb{matching_size(worker)};
+        if (nuncovered_lb == 0 && in_is_connected && in_root != -1) {
+            record(in, nin);
+            return;
+        }
+        if (nin + std::max(nuncovered_lb, in_is_connected ? 0 : 1) >= _best_size) return;
+
+        // Branch on the undecided vertex with the most undecided neighbors while there are uncovered
+        // edges, and then on the one with the most neighbors in `in`, to connect it.
+        int v{-1};
+        int best_score{-1};
+        for_each_bit(worker.undecided, [&](const int u) {
+            const auto neighs = row(u);
+            int score{0};
+            for (std::size_t w{0}; w < _words; ++w)
+                score += std::popcount(neighs[w] & (nuncovered_lb != 0 ? worker.undecided[w] : in[w]));
+            if (score > best_score) {
+                best_score = score;
+                v = u;
+            }
+        });
+        if (v == -1 || best_score == 0) return;
+
+        const auto child_in = worker.in(depth + 1);
+        const auto child_out = worker.out(depth + 1);
+        const auto neighs = row(v);
+
+        // take v
+        std::ranges::copy(in, child_in.begin());
+        std::ranges::copy(out, child_out.begin());
+        set_bit(child_in, v);
+        search(worker, depth + 1);
+
+        // leave v out and take its neighbors instead
+        std::ranges::copy(in, child_in.begin());
+        std::ranges::copy(out, child_out.begin());
+        set_bit(child_out, v);
+        for (std::size_t w{0}; w < _words; ++w)
+            child_in[w] |= neighs[w];
+        search(worker, depth + 1);
+    }
+};
+
+std::vector<int> find_cvc_by_backtracking(const Csr_graph& g, const unsigned threads)
+{
+    Branch_and_bound bnb{g};
+    return bnb.solve(std::max(1U, threads));
 }
@@ -1,9 +1,12 @@
 #ifndef SRC_MIN_CVC_BACKTRACKING_H_INCLUDED
 #define SRC_MIN_CVC_BACKTRACKING_H_INCLUDED
 
-#include "simple_graph.h"
-#include <set>
+#include "csr_graph.h"
+#include <vector>
 
-std::set<int> find_cvc_by_backtracking(const Simple_graph& g);
+/// Finds a minimum connected vertex cover of `g` by branch and bound, splitting the search tree
+/// across `threads` threads.  Returns its vertices in increasing order, or an empty vector if the
+/// edges of `g` do not all lie in one component.
+std::vector<int> find_cvc_by_backtracking(const Csr_graph& g, const unsigned threads);
 
 #endif // SRC_MIN_CVC_BACKTRACKING_H_INCLUDED
@@ -1,70 +1,180 @@
 #include "bitmasking.h"
 
 #include <algorithm>
+#include <atomic>
 #include <bit>
+#include <cstddef>
 #include <cstdint>
-#include <functional>
-#include <iterator>
-#include <set>
+#include <mutex>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <utility>
 #include <vector>
 
-constexpr std::uint64_t one_u64{1};
+using Word = std::uint64_t;
+constexpr std::size_t word_bits{64};
+constexpr Word one_word{1};
 
-/// Checks if the `selection` of vertices forms a connected vertex cover of `g`.
-bool selection_is_cvc(const Simple_graph& g, std::uint64_t mask)
-{
-    std::vector<int> selection;
-    std::vector<bool> is_selected(g.order(), false);
-
-    // check if all edges are covered
-    std::set<std::pair<int, int>> covered;
-    for (int v{0}; mask != 0; mask >>= 1U, ++v) {
-        if ((mask & one_u64) != 0) {
-            selection.push_back(v);
-            is_selected[v] = true;
-            for (const auto u : g.neighbors(v))
-                covered.emplace(std::min(u, v), std::max(u, v));
+/// Checks selections of the vertices of a graph, given as bitsets, for being connected vertex
+/// covers, using precomputed adjacency bitsets and preallocated scratch space.
+class Cvc_checker {
+public:
+    Cvc_checker(const std::vector<Word>& adj, const std::size_t words) :
+        _adj{adj}, _words{words}, _reached(words), _frontier(words), _next(words)
+    {
+    }
+
+    /// Checks if the `selection` (one bit per vertex, of a graph of `n` vertices) forms a connected
+    /// vertex cover: no unselected vertex may have an unselected neighbor, and a bit-parallel BFS
+    /// from the lowest selected vertex must reach every selected vertex.
+    bool is_cvc(const std::span<const Word> selection, const int n)
+    {
+        for (int v{0}; v < n; ++v) {
+            if (test(selection, v)) continue;
+            const auto neighs = row(v);
+            for (std::size_t w{0}; w < _words; ++w)
+                if ((neighs[w] & ~selection[w]) != 0) return false;
+        }
+
+        std::size_t first{0};
+        while (first < _words && selection[first] == 0)
+            ++first;
+        if (first == _words) return true;
+
+        std::ranges::fill(_reached, Word{0});
+        std::ranges::fill(_frontier, Word{0});
+        _frontier[first] = selection[first] & -selection[first];
+        _reached[first] = _frontier[first];
+        for (bool grew{true}; grew;) {
+            std::ranges::fill(_next, Word{0});
+            for (std::size_t w{0}; w < _words; ++w) {
+                for (Word word{_frontier[w]}; word != 0; word &= word - 1) {
+                    const auto neighs = row(static_cast<int>(
+                        w * word_bits + static_cast<std::size_t>(std::countr_zero(word))));
+                    for (std::size_t x{0}; x < _words; ++x)
+                        _next[x] |= neighs[x];
+                }
+            }
+            grew = false;
+            for (std::size_t w{0}; w < _words; ++w) {
+                _frontier[w] = _next[w] & selection[w] & ~_reached[w];
+                _reached[w] |= _frontier[w];
+                grew = grew || _frontier[w] != 0;
+            }
         }
+        return std::ranges::equal(_reached, selection);
     }
-    if (std::ssize(covered) != g.size()) return false;
 
-    std::vector<bool> is_visited(g.order(), false);
+private:
+    const std::vector<Word>& _adj;
+    std::size_t _words;
+    std::vector<Word> _reached, _frontier, _next;
 
-    // visit all vertices connected to root
-    const std::function<void(int)> visit_connected = [&](const int v) {
-        is_visited[v] = true;
-        for (const auto u : g.neighbors(v))
-            if (is_selected[u] && !is_visited[u]) visit_connected(u);
-    };
-    const int root{*std::ranges::min_element(selection)};
-    visit_connected(root);
-
-    // if any vertex in selection is not visited, it's not connected to root and
-    // hence the selection of vertices is not connected
-    return std::ranges::all_of(selection, [&is_visited](const int v) { return is_visited[v]; });
+    [[nodiscard]] std::span<const Word> row(const int v) const
+    {
+        return std::span{_adj}.subspan(static_cast<std::size_t>(v) * _words, _words);
+    }
+
+    static bool test(const std::span<const Word> bits, const int v)
+    {
+        const auto i = static_cast<std::size_t>(v);
+        return ((bits[i / word_bits] >> (i % word_bits)) & one_word) != 0;
+    }
+};
+
+static void flip(const std::span<Word> bits, const int v)
+{
+    const auto i = static_cast<std::size_t>(v);
+    bits[i / word_bits] ^= one_word << (i % word_bits);
 }
 
-constexpr std::uint64_t next_selection(unsigned n, std::uint64_t mask)
+/// Advances the `k`-combination `comb` (in increasing order) of [0, `limit`) to its successor in
+/// colexicographic order, flipping the changed bits of `mask`.  Returns false after the last one.
+static bool next_combination(std::vector<int>& comb, const int limit, const std::span<Word> mask)
 {
-    if (mask == 0) return 1;
-    if (mask == (one_u64 << n) - 1) return 0;
-    const auto initial_zeros = static_cast<unsigned>(std::countr_zero(mask));
-    const auto subsequent_ones = static_cast<unsigned>(std::countr_one(mask >> initial_zeros));
-    const unsigned total{initial_zeros + subsequent_ones};
-    const std::uint64_t p{one_u64 << total};
-    mask &= ~(p - 1);
-    if (total == n) mask |= (one_u64 << (subsequent_ones + 1)) - 1;
-    else {
-        mask |= (one_u64 << (subsequent_ones - 1)) - 1;
-        mask |= p;
+    const auto k = comb.size();
+    std::size_t i{0};
+    while (i + 1 < k && comb[i] + 1 == comb[i + 1])
+        ++i;
+    if (k == 0 || comb[i] + 1 == (i + 1 < k ? comb[i + 1] : limit)) return false;
+
+    flip(mask, comb[i]);
+    flip(mask, ++comb[i]);
+    for (std::size_t j{0}; j < i; ++j) {
+        flip(mask, comb[j]);
+        comb[j] = static_cast<int>(j);
+        flip(mask, comb[j]);
     }
-    return mask;
+    return true;
 }
 
-std::uint64_t find_cvc_by_bitmasking(const Simple_graph& g)
+std::vector<int> find_cvc_by_bitmasking(const Csr_graph& g, const unsigned threads)
 {
-    std::uint64_t selection{1};
-    while (selection != 0 && !selection_is_cvc(g, selection))
-        selection = next_selection(static_cast<unsigned>(g.order()), selection);
-    return selection;
+    const int n{g.order()};
+    const std::size_t words{(static_cast<std::size_t>(n) + word_bits - 1) / word_bits};
+    std::vector<Word> adj(static_cast<std::size_t>(n) * words, 0);
+    for (int v{0}; v < n; ++v)
+        for (const auto u : g.neighbors(v))
+            flip(std::span{adj}.subspan(static_cast<std::size_t>(v) * words, words), u);
+
+    // The selections are tried layer by layer, in increasing order of cardinality, and within a
+    // layer in colexicographic order, which orders them by their largest vertices first.  So a
+    // layer is split into tasks by fixing its largest (or two largest) vertices, in colex order, and
+    // the selection found by the earliest task wins.
+    for (int k{1}; k <= n; ++k) {
+        std::vector<std::pair<int, int>> tasks; // the two largest vertices (the second is -1 if k == 1)
+        for (int top{k - 1}; top < n; ++top) {
+            if (k == 1) tasks.emplace_back(top, -1);
+            else
+                for (int second{k - 2}; second < top; ++second)
+                    tasks.emplace_back(top, second);
+        }
+
+        std::atomic<std::size_t> next_task{0};
+        std::atomic<std::size_t> found_task{tasks.size()};
+        std::mutex found_mutex;
+        std::vector<Word> found;
+
+        const auto work = [&]() {
+            Cvc_checker checker{adj, words};
+            std::vector<Word> mask(words);
+            std::vector<int> rest(static_cast<std::size_t>(std::max(k - 2, 0)));
+            for (std::size_t t{next_task++}; t < found_task; t = next_task++) {
+                const auto [top, second] = tasks[t];
+                std::ranges::fill(mask, Word{0});
+                std::iota(rest.begin(), rest.end(), 0);
+                for (const auto v : rest)
+                    flip(mask, v);
+                flip(mask, top);
+                if (second != -1) flip(mask, second);
+
+                do {
+                    if (!checker.is_cvc(mask, n)) continue;
+                    const std::scoped_lock lock{found_mutex};
+                    if (t < found_task) {
+                        found_task = t;
+                        found = mask;
+                    }
+                    break;
+                } while (t < found_task && next_combination(rest, std::max(second, 0), mask));
+            }
+        };
+        {
+            std::vector<std::jthread> pool;
+            for (unsigned i{1}; i < threads; ++i)
+                pool.emplace_back(work);
+            work();
+        }
+
+        if (found_task < tasks.size()) {
+            std::vector<int> res;
+            for (int v{0}; v < n; ++v)
+                if (((found[static_cast<std::size_t>(v) / word_bits] >>
+                      (static_cast<std::size_t>(v) % word_bits)) & one_word) != 0)
+                    res.push_back(v);
+            return res;
+        }
+    }
+    return {};
 }
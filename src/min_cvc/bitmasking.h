@@ -1,9 +1,13 @@
 #ifndef SRC_MIN_CVC_BITMASKING_H_INCLUDED
 #define SRC_MIN_CVC_BITMASKING_H_INCLUDED
 
-#include "simple_graph.h"
-#include <cstdint>
+#include "csr_graph.h"
+#include <vector>
 
-std::uint64_t find_cvc_by_bitmasking(const Simple_graph& g);
+/// Finds a minimum connected vertex cover of `g` by trying the vertex subsets as bitmasks, in
+/// increasing order of cardinality and then in colexicographic order, splitting every cardinality
+/// across `threads` threads.  Returns the vertices of the first subset that is a connected vertex
+/// cover in increasing order, or an empty vector if there is none.
+std::vector<int> find_cvc_by_bitmasking(const Csr_graph& g, const unsigned threads);
 
 #endif // SRC_MIN_CVC_BITMASKING_H_INCLUDED
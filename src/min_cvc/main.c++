@@ -3,80 +3,104 @@
 
 // ReSharper disable CppTemplateArgumentsCanBeDeduced
 
+#include <algorithm>
 #include <cassert>
-#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <exception>
 #include <ios>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <span>
+#include <thread>
 
 #include "backtracking.h"
 #include "bitmasking.h"
-#include "simple_graph.h"
+#include "csr_graph.h"
+#include "graph_io.h"
+#include "run_stats.h"
 
 /// Parses the command line.
-bool parse_cmd(const std::span<const char* const> args, bool& use_bitmasking);
+bool parse_cmd(const std::span<const char* const> args,
+               bool& use_bitmasking,
+               unsigned& threads,
+               bool& show_stats);
 
 /// Prints a help message showing the syntax of the command line.
 void show_usage(const char* const cmd_name);
 
-/// Inputs a value of type `T` from the `is` input stream and returns it.
-template<typename T> T scan(std::istream& is = std::cin);
-
 /// Prints the elements of the `container`, separating them by spaces.
 template<typename C> void output_elems(const C& container);
 
-/// Prints the indices of the set bits (1 bits) in the binary representation of `mask`, separating
-/// them by spaces.  Indexing starts at 0 on the least significant bit and increases rightwards.
-void output_set_bits(std::uint64_t mask);
-
 int main(const int argc, const char* const argv[])
 {
     std::ios_base::sync_with_stdio(false);
     std::cin.tie(nullptr);
-    std::cin.exceptions(std::ios_base::failbit);
 
     bool use_bitmasking{false};
-    if (const auto args = std::span(argv, argc); !parse_cmd(args, use_bitmasking)) {
+    unsigned threads{std::max(1U, std::thread::hardware_concurrency())};
+    bool show_stats{false};
+    if (const auto args = std::span(argv, argc);
+        !parse_cmd(args, use_bitmasking, threads, show_stats)) {
         show_usage(args[0]);
         return EXIT_FAILURE;
     }
 
-    Simple_graph g(scan<int>());
-    for (auto m = scan<int>(); m-- != 0;)
-        g.add_edge(scan<int>(), scan<int>());
+    Run_stats stats{show_stats};
+    int status{EXIT_FAILURE};
+    try {
+        stats.phase("read");
+        const Csr_graph g{read_graph(std::cin)};
 
-    if (use_bitmasking) {
-        const auto cvc_mask = find_cvc_by_bitmasking(g);
-        output_set_bits(cvc_mask);
+        stats.phase(use_bitmasking ? "bitmasking" : "backtracking");
+        const auto cvc = use_bitmasking ? find_cvc_by_bitmasking(g, threads)
+                                        : find_cvc_by_backtracking(g, threads);
+
+        stats.phase("output");
+        if (cvc.empty() && g.size() != 0) {
+            std::cerr << "The edges of the graph must all be in one component\n";
+        }
+        else {
+            output_elems(cvc);
+            std::cout << '\n';
+            status = 0;
+        }
     }
-    else {
-        const auto cvc = find_cvc_by_backtracking(g);
-        output_elems(cvc);
+    catch (const std::exception& e) { // e.g. a malformed graph on the standard input
+        std::cerr << argv[0] << ": " << e.what() << '\n';
     }
 
-    std::cout << '\n';
-    return 0;
+    stats.stop();
+    std::cout.flush();
+    stats.print(std::cerr);
+    return status;
 }
 
-[[nodiscard]] bool parse_cmd(const std::span<const char* const> args, bool& use_bitmasking)
+[[nodiscard]] bool parse_cmd(const std::span<const char* const> args,
+                             bool& use_bitmasking,
+                             unsigned& threads,
+                             bool& show_stats)
 {
-    use_bitmasking = args.size() == 2 && std::strcmp(args[1], "-m") == 0;
-    return args.size() == 1 || use_bitmasking;
+    use_bitmasking = false;
+    show_stats = false;
+    for (std::size_t i{1}; i < args.size(); ++i) {
+        if (std::strcmp(args[i], "-m") == 0) use_bitmasking = true;
+        else if (std::strcmp(args[i], "--stats") == 0) show_stats = true;
+        else if (std::strcmp(args[i], "-j") == 0 && i + 1 < args.size()) {
+            char* end{nullptr};
+            const unsigned long ul{std::strtoul(args[++i], &end, 10)};
+            if (*end != '\0' || ul == 0 || ul > std::numeric_limits<unsigned>::max()) return false;
+            threads = static_cast<unsigned>(ul);
+        }
+        else return false;
+    }
+    return true;
 }
 
 void show_usage(const char* const cmd_name)
 {
-    std::cerr << "usage: " << cmd_name << " [-m]\n";
-}
-
-template<typename T> [[nodiscard]] T scan(std::istream& is)
-{
-    T buf;
-    is >> buf;
-    return buf;
+    std::cerr << "usage: " << cmd_name << " [-m] [-j <threads>] [--stats]\n";
 }
 
 template<typename C> void output_elems(const C& container)
@@ -88,17 +112,3 @@ template<typename C> void output_elems(const C& container)
         std::cout << ' ';
     }
 }
-
-void output_set_bits(std::uint64_t mask)
-{
-    constexpr std::uint64_t one_u64{1};
-    for (int bit{0}; mask != 0; ++bit) {
-        if ((mask & one_u64) != 0) {
-            std::cout << bit;
-            mask >>= one_u64;
-            if (mask == 0) break;
-            std::cout << ' ';
-        }
-        else mask >>= one_u64;
-    }
-}
@@ -0,0 +1,123 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#include "run_stats.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <ios>
+#include <new>
+#include <ostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define RUN_STATS_HAS_GETRUSAGE 1
+#include <sys/resource.h>
+#endif
+
+// Only read by `operator new` unless counting is enabled, so the shared counters are not contended
+// by runs without `--stats`.
+static std::atomic<bool> is_counting{false};
+static std::atomic<std::uint64_t> nallocations{0};
+static std::atomic<std::uint64_t> nallocated_bytes{0};
+
+void* operator new(const std::size_t size)
+{
+    if (is_counting.load(std::memory_order_relaxed)) {
+        nallocations.fetch_add(1, std::memory_order_relaxed);
+        nallocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    if (void* const p{std::malloc(size == 0 ? 1 : size)}) return p; // NOLINT(*-no-malloc)
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* const p) noexcept
+{
+    std::free(p); // NOLINT(*-no-malloc)
+}
+
+void operator delete(void* const p, std::size_t /*size*/) noexcept
+{
+    std::free(p); // NOLINT(*-no-malloc)
+}
+
+void enable_allocation_counting()
+{
+    is_counting.store(true, std::memory_order_relaxed);
+}
+
+std::uint64_t allocation_count()
+{
+    return nallocations.load(std::memory_order_relaxed);
+}
+
+std::uint64_t allocated_bytes()
+{
+    return nallocated_bytes.load(std::memory_order_relaxed);
+}
+
+long peak_rss_kib()
+{
+#ifdef RUN_STATS_HAS_GETRUSAGE
+    rusage usage{};
+    if (::getrusage(RUSAGE_SELF, &usage) == -1) return -1;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // in bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return -1;
+#endif
+}
+
+Run_stats::Run_stats(const bool enabled) : _enabled{enabled}
+{
+    if (_enabled) enable_allocation_counting();
+}
+
+void Run_stats::phase(const char* const name)
+{
+    if (!_enabled) return;
+    stop();
+    _phases.push_back({name, {}, 0, 0, 0});
+    _in_phase = true;
+    _start_allocations = allocation_count();
+    _start_bytes = allocated_bytes();
+    _start = Clock::now();
+}
+
+void Run_stats::stop()
+{
+    if (!_in_phase) return;
+    auto& current = _phases.back();
+    current.wall = Clock::now() - _start;
+    current.allocations = allocation_count() - _start_allocations;
+    current.bytes = allocated_bytes() - _start_bytes;
+    current.peak_rss_kib = peak_rss_kib();
+    _in_phase = false;
+}
+
+void Run_stats::print(std::ostream& os) const
+{
+    if (!_enabled) return;
+
+    Phase total{"total", {}, 0, 0, peak_rss_kib()};
+    const auto print_row = [&os](const Phase& p) {
+        os << p.name << '\t' << p.wall.count() << '\t' << p.allocations << '\t' << p.bytes << '\t'
+           << p.peak_rss_kib << '\n';
+    };
+
+    const auto old_flags = os.flags();
+    os << std::fixed;
+    os << "phase\twall_s\tallocations\tallocated_bytes\tpeak_rss_kib\n";
+    for (const auto& p : _phases) {
+        print_row(p);
+        total.wall += p.wall;
+        total.allocations += p.allocations;
+        total.bytes += p.bytes;
+    }
+    print_row(total);
+    os.flags(old_flags);
+}
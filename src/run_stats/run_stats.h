@@ -0,0 +1,68 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef RUN_STATS_H_INCLUDED
+#define RUN_STATS_H_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// Makes the global `operator new` count its calls and the bytes they request from now on.  (Linking
+/// this library replaces the global `operator new` and `operator delete`; until this is called,
+/// they only test a flag before forwarding to `std::malloc()` and `std::free()`.)
+void enable_allocation_counting();
+
+/// Returns the number of calls of the global `operator new` since allocation counting was enabled.
+std::uint64_t allocation_count();
+
+/// Returns the number of bytes requested from the global `operator new` since allocation counting
+/// was enabled.
+std::uint64_t allocated_bytes();
+
+/// Returns the peak resident set size of this process so far in KiB, or -1 if it is unknown.
+long peak_rss_kib();
+
+/// Collects the wall time, the allocations and the peak resident set size of the consecutive phases
+/// of a run.  A disabled instance records nothing and leaves allocation counting off.
+class Run_stats {
+public:
+    explicit Run_stats(const bool enabled);
+
+    /// Ends the current phase, if any, and starts a new one called `name`.
+    void phase(const char* const name);
+
+    /// Ends the current phase, if any.
+    void stop();
+
+    /// Writes a header and then one tab-separated row per phase, followed by a row for the whole run,
+    /// to `os`:
+    ///
+    ///     phase  wall_s  allocations  allocated_bytes  peak_rss_kib
+    ///
+    /// where `peak_rss_kib` is the peak resident set size of the process at the end of the phase.
+    void print(std::ostream& os) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Phase {
+        std::string name;
+        std::chrono::duration<double> wall;
+        std::uint64_t allocations;
+        std::uint64_t bytes;
+        long peak_rss_kib;
+    };
+
+    bool _enabled;
+    std::vector<Phase> _phases;
+
+    bool _in_phase{false};
+    Clock::time_point _start; ///< the start of the current phase
+    std::uint64_t _start_allocations{0};
+    std::uint64_t _start_bytes{0};
+};
+
+#endif // RUN_STATS_H_INCLUDED
@@ -0,0 +1,40 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#include "csr_graph.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "simple_graph.h"
+
+Csr_graph::Csr_graph(const Simple_graph& g) : _n{g.order()}, _m{g.size()}
+{
+    _offsets.reserve(static_cast<std::size_t>(_n) + 1);
+    _targets.reserve(2 * static_cast<std::size_t>(_m));
+
+    _offsets.push_back(0);
+    for (int v{0}; v < _n; ++v) {
+        const auto neighs = g.neighbors(v);
+        _targets.insert(_targets.end(), neighs.begin(), neighs.end());
+        _offsets.push_back(static_cast<int>(_targets.size()));
+    }
+}
+
+Csr_graph::Csr_graph(std::vector<int> offsets, std::vector<int> targets)
+    : _n{static_cast<int>(offsets.size()) - 1},
+      _m{static_cast<int>(targets.size() / 2)},
+      _offsets{std::move(offsets)},
+      _targets{std::move(targets)}
+{
+    if (_n <= 0) throw std::invalid_argument{"order must be positive"};
+    if (_offsets.front() != 0 || _offsets.back() != static_cast<int>(_targets.size()) ||
+        !std::ranges::is_sorted(_offsets))
+        throw std::invalid_argument{"offsets must be non-decreasing from 0 to the number of targets"};
+    if (_targets.size() % 2 != 0)
+        throw std::invalid_argument{"the number of targets must be even"};
+    if (std::ranges::any_of(_targets, [this](const int u) { return u < 0 || u >= _n; }))
+        throw std::out_of_range{"neighbor out of range"};
+}
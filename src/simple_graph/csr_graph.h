@@ -0,0 +1,59 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef CSR_GRAPH_H_INCLUDED
+#define CSR_GRAPH_H_INCLUDED
+
+#include <span>
+#include <vector>
+
+#include "simple_graph.h"
+
+/// An immutable graph stored in compressed sparse row (CSR) form: the neighbors of vertex `v` are
+/// `targets[offsets[v]]`, ..., `targets[offsets[v + 1] - 1]`.  Meant to be built once after the
+/// input is read and then shared, read-only, by the algorithms.
+class Csr_graph {
+public:
+    /// Freezes `g`, keeping the order of every neighbor list.
+    /// Time complexity: O(order + size)
+    explicit Csr_graph(const Simple_graph& g);
+
+    /// @param offsets `order + 1` non-decreasing indices into `targets`, starting at 0
+    /// @param targets the concatenated neighbor lists, an even number of vertices in range; every
+    ///                edge should appear in both directions, which is not checked
+    Csr_graph(std::vector<int> offsets, std::vector<int> targets);
+
+    /// Returns the number of vertices in the graph.
+    [[nodiscard]] int order() const { return _n; }
+
+    /// Returns the number of edges in the graph.
+    [[nodiscard]] int size() const { return _m; }
+
+    /// Returns a view of the neighbors of vertex `v`, which must be in the range [0, order).
+    [[nodiscard]] std::span<const int> neighbors(const int v) const
+    {
+        const auto first = static_cast<std::size_t>(_offsets[static_cast<std::size_t>(v)]);
+        const auto last = static_cast<std::size_t>(_offsets[static_cast<std::size_t>(v) + 1]);
+        return std::span<const int>{_targets}.subspan(first, last - first);
+    }
+
+    /// Returns the number of neighbors of vertex `v`, which must be in the range [0, order).
+    [[nodiscard]] int degree(const int v) const
+    {
+        return _offsets[static_cast<std::size_t>(v) + 1] - _offsets[static_cast<std::size_t>(v)];
+    }
+
+    /// Returns the `order + 1` row offsets.
+    [[nodiscard]] std::span<const int> offsets() const { return _offsets; }
+
+    /// Returns the concatenated neighbor lists.
+    [[nodiscard]] std::span<const int> targets() const { return _targets; }
+
+private:
+    int _n;                    ///< number of vertices
+    int _m;                    ///< number of edges
+    std::vector<int> _offsets; ///< start of each vertex's neighbors in `_targets`, plus a sentinel
+    std::vector<int> _targets; ///< the neighbor lists, back to back
+};
+
+#endif // CSR_GRAPH_H_INCLUDED
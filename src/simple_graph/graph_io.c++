@@ -0,0 +1,296 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#include "graph_io.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GRAPH_IO_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+constexpr std::string_view binary_magic{"CSRG"};
+constexpr std::uint32_t binary_version{1};
+constexpr std::size_t binary_header_size{16};
+
+/// Scans non-negative or negative decimal integers separated by whitespace, without the locale and
+/// stream machinery of `operator>>`.
+class Int_scanner {
+public:
+    explicit Int_scanner(const std::string_view data) : _data{data} {}
+
+    int next()
+    {
+        while (_pos < _data.size() && is_space(_data[_pos]))
+            ++_pos;
+        if (_pos == _data.size()) throw std::runtime_error{"unexpected end of input"};
+
+        const bool negative{_data[_pos] == '-'};
+        if (negative || _data[_pos] == '+') ++_pos;
+
+        const std::size_t first{_pos};
+        long long value{0};
+        for (; _pos < _data.size() && '0' <= _data[_pos] && _data[_pos] <= '9'; ++_pos) {
+            value = 10 * value + (_data[_pos] - '0');
+            if (value > std::numeric_limits<int>::max())
+                throw std::runtime_error{"integer out of range"};
+        }
+        if (_pos == first || (_pos < _data.size() && !is_space(_data[_pos])))
+            throw std::runtime_error{"expected an integer"};
+
+        return static_cast<int>(negative ? -value : value);
+    }
+
+private:
+    std::string_view _data;
+    std::size_t _pos{0};
+
+    static bool is_space(const char c)
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+    }
+};
+
+static Csr_graph parse_text_graph(const std::string_view data)
+{
+    Int_scanner scanner{data};
+    const int n{scanner.next()};
+    if (n <= 0) throw std::invalid_argument{"order must be positive"};
+    const int m{scanner.next()};
+    if (m < 0 || static_cast<std::size_t>(m) > data.size())
+        throw std::runtime_error{"invalid number of edges"};
+
+    std::vector<int> ends(2 * static_cast<std::size_t>(m));
+    std::vector<int> offsets(static_cast<std::size_t>(n) + 1, 0);
+    for (std::size_t i{0}; i < ends.size(); i += 2) {
+        const int u{scanner.next()};
+        const int v{scanner.next()};
+        if (u < 0 || u >= n || v < 0 || v >= n) throw std::out_of_range{"vertex out of range"};
+        if (u == v) throw std::invalid_argument{"edges must not be self-loops"};
+        ends[i] = u;
+        ends[i + 1] = v;
+        ++offsets[static_cast<std::size_t>(u) + 1];
+        ++offsets[static_cast<std::size_t>(v) + 1];
+    }
+    for (std::size_t v{1}; v < offsets.size(); ++v)
+        offsets[v] += offsets[v - 1];
+
+    // place the edges in input order, as `Simple_graph::add_edge()` would
+    std::vector<int> next(offsets.begin(), offsets.end() - 1);
+    std::vector<int> targets(ends.size());
+    for (std::size_t i{0}; i < ends.size(); i += 2) {
+        const auto u = static_cast<std::size_t>(ends[i]);
+        const auto v = static_cast<std::size_t>(ends[i + 1]);
+        targets[static_cast<std::size_t>(next[u]++)] = ends[i + 1];
+        targets[static_cast<std::size_t>(next[v]++)] = ends[i];
+    }
+    return Csr_graph{std::move(offsets), std::move(targets)};
+}
+
+/// Copies `count` little-endian 32-bit integers from `bytes` into `out`.
+static void copy_le32(const char* const bytes, const std::size_t count, std::vector<int>& out)
+{
+    out.resize(count);
+    if constexpr (std::endian::native == std::endian::little) {
+        std::memcpy(out.data(), bytes, 4 * count);
+    }
+    else {
+        for (std::size_t i{0}; i < count; ++i) {
+            std::uint32_t word{0};
+            for (std::size_t b{0}; b < 4; ++b)
+                word |= static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[4 * i + b])) << (8 * b);
+            out[i] = static_cast<int>(word);
+        }
+    }
+}
+
+/// Returns the transpose of the directed graph with the row `offsets` and `targets`, whose rows list
+/// their entries in increasing order.
+static std::pair<std::vector<int>, std::vector<int>> transpose(const std::vector<int>& offsets,
+                                                               const std::vector<int>& targets)
+{
+    std::vector<int> t_offsets(offsets.size(), 0);
+    for (const auto u : targets)
+        ++t_offsets[static_cast<std::size_t>(u) + 1];
+    for (std::size_t v{1}; v < t_offsets.size(); ++v)
+        t_offsets[v] += t_offsets[v - 1];
+
+    std::vector<int> next(t_offsets.begin(), t_offsets.end() - 1);
+    std::vector<int> t_targets(targets.size());
+    for (std::size_t v{0}; v + 1 < offsets.size(); ++v)
+        for (auto i = static_cast<std::size_t>(offsets[v]); i < static_cast<std::size_t>(offsets[v + 1]); ++i)
+            t_targets[static_cast<std::size_t>(next[static_cast<std::size_t>(targets[i])]++)] = static_cast<int>(v);
+    return {std::move(t_offsets), std::move(t_targets)};
+}
+
+/// Checks that the graph `g` read from a binary file is undirected and simple in the sense of the
+/// text format: no self-loops, and every entry `v -> u` is matched by an entry `u -> v` (as often).
+/// The transpose of `g` lists the same neighbors as `g` iff `g` is symmetric, and transposing twice
+/// sorts the rows, so comparing the first and the second transpose takes O(order + size) time.
+static void check_undirected(const Csr_graph& g)
+{
+    const std::vector<int> offsets(g.offsets().begin(), g.offsets().end());
+    const std::vector<int> targets(g.targets().begin(), g.targets().end());
+    for (int v{0}; v < g.order(); ++v)
+        if (std::ranges::find(g.neighbors(v), v) != g.neighbors(v).end())
+            throw std::invalid_argument{"edges must not be self-loops"};
+
+    const auto once = transpose(offsets, targets);
+    if (once.first != offsets || once != transpose(once.first, once.second))
+        throw std::invalid_argument{"every edge must be stored in both directions"};
+}
+
+static Csr_graph parse_binary_graph(const std::string_view data)
+{
+    if (data.size() < binary_header_size) throw std::runtime_error{"truncated header"};
+
+    std::vector<int> header;
+    copy_le32(data.data() + binary_magic.size(), 3, header);
+    const auto version = static_cast<std::uint32_t>(header[0]);
+    const auto n = static_cast<std::uint32_t>(header[1]);
+    const auto ntargets = static_cast<std::uint32_t>(header[2]);
+    if (version != binary_version) throw std::runtime_error{"unsupported format version"};
+    if (data.size() != binary_header_size + 4 * (std::size_t{n} + 1 + ntargets))
+        throw std::runtime_error{"size does not match the header"};
+
+    std::vector<int> offsets;
+    std::vector<int> targets;
+    copy_le32(data.data() + binary_header_size, std::size_t{n} + 1, offsets);
+    copy_le32(data.data() + binary_header_size + 4 * (std::size_t{n} + 1), ntargets, targets);
+    Csr_graph g{std::move(offsets), std::move(targets)};
+    check_undirected(g);
+    return g;
+}
+
+Csr_graph parse_graph(const std::string_view data)
+{
+    return data.starts_with(binary_magic) ? parse_binary_graph(data) : parse_text_graph(data);
+}
+
+Csr_graph read_graph(std::istream& is)
+{
+    std::string data;
+    std::array<char, 1 << 16> buf{};
+    while (is.read(buf.data(), buf.size()) || is.gcount() > 0)
+        data.append(buf.data(), static_cast<std::size_t>(is.gcount()));
+    return parse_graph(data);
+}
+
+#ifdef GRAPH_IO_HAS_MMAP
+
+/// A read-only memory mapping of a whole file.
+class Mapped_file {
+public:
+    explicit Mapped_file(const std::string& path)
+    {
+        const int fd{::open(path.c_str(), O_RDONLY)}; // NOLINT(*-vararg)
+        if (fd == -1) throw std::runtime_error{path + ": cannot open file"};
+
+        struct stat st {};
+        if (::fstat(fd, &st) == -1) {
+            ::close(fd);
+            throw std::runtime_error{path + ": cannot stat file"};
+        }
+        _size = static_cast<std::size_t>(st.st_size);
+        if (_size != 0) {
+            _addr = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (_addr == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error{path + ": cannot map file"};
+            }
+            ::madvise(_addr, _size, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+    }
+
+    Mapped_file(const Mapped_file&) = delete;
+    Mapped_file& operator=(const Mapped_file&) = delete;
+
+    ~Mapped_file()
+    {
+        if (_size != 0) ::munmap(_addr, _size);
+    }
+
+    [[nodiscard]] std::string_view data() const
+    {
+        return _size == 0 ? std::string_view{} : std::string_view{static_cast<const char*>(_addr), _size};
+    }
+
+private:
+    void* _addr{nullptr};
+    std::size_t _size{0};
+};
+
+Csr_graph load_graph(const std::string& path)
+{
+    const Mapped_file file{path};
+    try {
+        return parse_graph(file.data());
+    }
+    catch (const std::runtime_error& e) {
+        throw std::runtime_error{path + ": " + e.what()};
+    }
+}
+
+#else
+
+Csr_graph load_graph(const std::string& path)
+{
+    std::ifstream file{path, std::ios_base::binary};
+    if (!file) throw std::runtime_error{path + ": cannot open file"};
+    try {
+        return read_graph(file);
+    }
+    catch (const std::runtime_error& e) {
+        throw std::runtime_error{path + ": " + e.what()};
+    }
+}
+
+#endif
+
+void write_binary_graph(const Csr_graph& g, std::ostream& os)
+{
+    const auto write_le32 = [&os](const std::span<const int> ints) {
+        if constexpr (std::endian::native == std::endian::little) {
+            // NOLINTNEXTLINE(*-reinterpret-cast)
+            os.write(reinterpret_cast<const char*>(ints.data()),
+                     static_cast<std::streamsize>(4 * ints.size()));
+        }
+        else {
+            for (const auto i : ints) {
+                const auto word = static_cast<std::uint32_t>(i);
+                for (std::size_t b{0}; b < 4; ++b)
+                    os.put(static_cast<char>((word >> (8 * b)) & 0xFFU));
+            }
+        }
+    };
+
+    os.write(binary_magic.data(), static_cast<std::streamsize>(binary_magic.size()));
+    const std::array<int, 3> header{static_cast<int>(binary_version),
+                                    g.order(),
+                                    static_cast<int>(g.targets().size())};
+    write_le32(header);
+    write_le32(g.offsets());
+    write_le32(g.targets());
+}
@@ -0,0 +1,35 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+#ifndef GRAPH_IO_H_INCLUDED
+#define GRAPH_IO_H_INCLUDED
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "csr_graph.h"
+
+/// Parses a graph from `data`, which holds either
+///   - the text format described in the README (the order, the size, and then one edge per line),
+///     or
+///   - the binary format written by `write_binary_graph()`, recognized by its leading magic bytes.
+/// The neighbors of every vertex are kept in the order of the edges in the text.  Throws
+/// `std::runtime_error` if the data is malformed or ends early, and `std::invalid_argument` or
+/// `std::out_of_range` if it does not describe a valid graph.
+Csr_graph parse_graph(std::string_view data);
+
+/// Reads all of `is` and parses it with `parse_graph()`.
+Csr_graph read_graph(std::istream& is);
+
+/// Memory-maps the file at `path` (or reads it where memory mapping is unavailable) and parses it
+/// with `parse_graph()`.  Throws `std::runtime_error` if the file cannot be read.
+Csr_graph load_graph(const std::string& path);
+
+/// Writes `g` in the binary format: a 16-byte header (the magic bytes `CSRG`, the format version,
+/// the order, and the number of neighbor entries, i.e. twice the size), followed by the `order + 1`
+/// row offsets and then the neighbor entries, all as little-endian 32-bit integers.
+void write_binary_graph(const Csr_graph& g, std::ostream& os);
+
+#endif // GRAPH_IO_H_INCLUDED
@@ -1,7 +1,9 @@
 // This is a personal academic project. Dear PVS-Studio, please check it.
 // PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
 
-#include <istream>
+#include <algorithm>
+#include <span>
+#include <stdexcept>
 #include <vector>
 
 #include "simple_graph.h"
@@ -12,9 +14,9 @@ Simple_graph::Simple_graph(const int order) : _n{validate_order(order)}, _adj(or
 
 [[nodiscard]] int Simple_graph::size() const { return _m; }
 
-[[nodiscard]] std::vector<std::vector<int>> Simple_graph::adj_data() const { return _adj; }
+[[nodiscard]] const std::vector<std::vector<int>>& Simple_graph::adj_data() const { return _adj; }
 
-[[nodiscard]] std::vector<int> Simple_graph::neighbors(const int v) const { return _adj.at(v); }
+[[nodiscard]] std::span<const int> Simple_graph::neighbors(const int v) const { return _adj.at(v); }
 
 [[nodiscard]] int Simple_graph::degree(const int v) const { return static_cast<int>(_adj.at(v).size()); }
 
@@ -4,6 +4,7 @@
 #ifndef GRAPH_H_INCLUDED
 #define GRAPH_H_INCLUDED
 
+#include <span>
 #include <vector>
 
 class Simple_graph {
@@ -18,10 +19,11 @@ public:
     [[nodiscard]] int size() const;
 
     /// Returns the adjacency list of the graph.
-    [[nodiscard]] std::vector<std::vector<int>> adj_data() const;
+    [[nodiscard]] const std::vector<std::vector<int>>& adj_data() const;
 
-    /// Returns the neighbors of vertex `v`.
-    [[nodiscard]] std::vector<int> neighbors(const int v) const;
+    /// Returns a view of the neighbors of vertex `v`.
+    /// The view is invalidated by any edge added to or removed from vertex `v`.
+    [[nodiscard]] std::span<const int> neighbors(const int v) const;
 
     /// Returns the number of neighbors of vertex `v`.
     [[nodiscard]] int degree(const int v) const;
@@ -0,0 +1,130 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: https://pvs-studio.com
+
+// Replays the edge updates given to `ilst_cvc --dynamic` on the initial graph and checks every line
+// the program printed: `-1` exactly when the graph is disconnected after the batch, and otherwise a
+// connected vertex cover of the graph, as judged by `Cvc_validator`.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "csr_graph.h"
+#include "cvc.h"
+#include "graph_io.h"
+#include "simple_graph.h"
+
+/// Checks the line `line` printed after batch `batch` against the graph `g` after that batch.
+/// Returns false after reporting a mismatch on `std::cerr`.
+static bool check_line(const Simple_graph& g, const std::string& line, const int batch)
+{
+    const Csr_graph csr{g};
+    const bool connected{is_connected(csr)};
+    if (line == "-1") {
+        if (connected) std::cerr << "batch " << batch << ": printed -1 for a connected graph\n";
+        return !connected;
+    }
+    if (!connected) {
+        std::cerr << "batch " << batch << ": printed a cover for a disconnected graph\n";
+        return false;
+    }
+
+    std::vector<int> cover;
+    std::istringstream is{line};
+    for (int v{0}; is >> v;) {
+        if (v < 0 || v >= g.order()) {
+            std::cerr << "batch " << batch << ": vertex " << v << " out of range\n";
+            return false;
+        }
+        cover.push_back(v);
+    }
+    if (!is.eof() || cover.empty()) {
+        std::cerr << "batch " << batch << ": malformed line `" << line << "`\n";
+        return false;
+    }
+
+    Cvc_validator validator{csr};
+    const auto res = validator.check(cover);
+    if (!res.is_cvc) {
+        std::cerr << "batch " << batch << ": ";
+        if (res.uncovered_edge.first != -1)
+            std::cerr << "edge " << res.uncovered_edge.first << ' ' << res.uncovered_edge.second
+                      << " is not covered\n";
+        else std::cerr << "vertex " << res.disconnected_vertex << " is disconnected from the cover\n";
+    }
+    return res.is_cvc;
+}
+
+int main(const int argc, const char* const argv[])
+{
+    const auto args = std::span(argv, static_cast<std::size_t>(argc));
+    if (args.size() != 4) {
+        std::cerr << "usage: " << args[0] << " <graph file> <updates file> <output file>\n";
+        return EXIT_FAILURE;
+    }
+
+    try {
+        const Csr_graph initial{load_graph(args[1])};
+        Simple_graph g{initial.order()};
+        for (int v{0}; v < initial.order(); ++v)
+            for (const auto u : initial.neighbors(v))
+                if (v < u) g.add_edge(v, u);
+
+        std::ifstream updates{args[2]};
+        std::ifstream output{args[3]};
+        if (!updates || !output) {
+            std::cerr << "cannot open the updates or the output file\n";
+            return EXIT_FAILURE;
+        }
+
+        int batch{0};
+        bool pending{false};
+        bool all_valid{true};
+        const auto end_batch = [&]() {
+            std::string line;
+            if (!std::getline(output, line)) {
+                std::cerr << "batch " << batch << ": no output line\n";
+                all_valid = false;
+            }
+            else if (!check_line(g, line, batch)) all_valid = false;
+            ++batch;
+            pending = false;
+        };
+
+        // apply the updates as `Dynamic_cvc` does, ignoring the invalid ones
+        for (std::string op; updates >> op;) {
+            if (op == ".") {
+                end_batch();
+                continue;
+            }
+            int u{-1};
+            int v{-1};
+            updates >> u >> v;
+            pending = true;
+            if (u == v || u < 0 || v < 0 || u >= g.order() || v >= g.order()) continue;
+            const auto neighs = g.neighbors(u);
+            const bool adjacent{std::ranges::find(neighs, v) != neighs.end()};
+            if (op == "+" && !adjacent) g.add_edge(u, v);
+            else if (op == "-" && adjacent) g.remove_edge(u, v);
+        }
+        if (pending) end_batch();
+
+        if (std::string extra; std::getline(output, extra)) {
+            std::cerr << "more output lines than batches\n";
+            all_valid = false;
+        }
+        std::cout << batch << " batches checked\n";
+        return all_valid ? 0 : EXIT_FAILURE;
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}
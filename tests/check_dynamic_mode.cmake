@@ -0,0 +1,24 @@
+# Runs `ilst_cvc --dynamic` on GRAPH with the updates in UPDATES and the heuristic HEURISTIC, and
+# checks every printed line with CHECKER (check_dynamic_covers).
+#
+# usage: cmake -DILST_CVC=<ilst_cvc executable> -DCHECKER=<check_dynamic_covers executable>
+#              -DGRAPH=<graph file> -DUPDATES=<updates file> -DHEURISTIC=<heuristic>
+#              -DOUTPUT=<file to write the output to> -P check_dynamic_mode.cmake
+
+execute_process(
+    COMMAND "${ILST_CVC}" --dynamic "${GRAPH}" ${HEURISTIC}
+    INPUT_FILE "${UPDATES}"
+    OUTPUT_FILE "${OUTPUT}"
+    RESULT_VARIABLE status
+)
+if(NOT status EQUAL 0)
+    message(FATAL_ERROR "ilst_cvc --dynamic exited with ${status}")
+endif()
+
+execute_process(
+    COMMAND "${CHECKER}" "${GRAPH}" "${UPDATES}" "${OUTPUT}"
+    RESULT_VARIABLE status
+)
+if(NOT status EQUAL 0)
+    message(FATAL_ERROR "the output of ilst_cvc --dynamic ${HEURISTIC} failed the checks")
+endif()
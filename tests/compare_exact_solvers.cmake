@@ -0,0 +1,40 @@
+# Runs min_cvc with its branch-and-bound search and with its bitmask enumeration (`-m`) on every
+# graph file in GRAPH_DIR and fails if the two minimum connected vertex covers differ in size.
+#
+# usage: cmake -DMIN_CVC=<min_cvc executable> -DGRAPH_DIR=<directory> -P compare_exact_solvers.cmake
+
+if(NOT IS_DIRECTORY "${GRAPH_DIR}")
+    message(STATUS "${GRAPH_DIR}: no such directory; nothing to compare")
+    return()
+endif()
+
+file(GLOB graphs "${GRAPH_DIR}/*.txt")
+list(SORT graphs)
+foreach(graph ${graphs})
+    foreach(mode backtracking bitmasking)
+        if(mode STREQUAL "bitmasking")
+            set(flags -m)
+        else()
+            set(flags)
+        endif()
+        execute_process(
+            COMMAND "${MIN_CVC}" ${flags}
+            INPUT_FILE "${graph}"
+            OUTPUT_VARIABLE cover
+            RESULT_VARIABLE status
+        )
+        if(NOT status EQUAL 0)
+            message(FATAL_ERROR "${graph}: min_cvc ${flags} exited with ${status}")
+        endif()
+        string(STRIP "${cover}" cover)
+        string(REPLACE " " ";" cover "${cover}")
+        list(LENGTH cover ${mode}_size)
+    endforeach()
+
+    if(NOT backtracking_size EQUAL bitmasking_size)
+        message(FATAL_ERROR
+            "${graph}: branch and bound found a cover of size ${backtracking_size}, "
+            "bitmask enumeration one of size ${bitmasking_size}")
+    endif()
+    message(STATUS "${graph}: ${backtracking_size}")
+endforeach()